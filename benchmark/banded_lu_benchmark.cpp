@@ -0,0 +1,63 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "../src/BandedLU.h"
+#include "../src/SparseLU.h"
+
+/**
+ * @brief Runs the callable repeatedly for at least 0.2 seconds and returns the mean time in microseconds.
+ */
+template<typename Callable>
+double timeMicroseconds(Callable&& callable) {
+    auto start = std::chrono::steady_clock::now();
+    unsigned int repetitions = 0;
+    double elapsed = 0.0;
+    do {
+        callable();
+        repetitions++;
+        elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    } while (elapsed < 2e5);
+    return elapsed / repetitions;
+}
+
+/**
+ * @brief Band matrix with bandwidth k on both sides that is not diagonally dominant, so that rows are interchanged.
+ */
+BandedMatrix testMatrix(unsigned int n, unsigned int k) {
+    BandedMatrix A(n, k, k);
+    for (unsigned int i = 0; i < n; i++) {
+        for (unsigned int j = i > k ? i - k : 0; j < std::min(n, i + k + 1); j++) {
+            A(i, j) = sin(1.0 + i + 3.0 * j) + (i == j ? 1.0 : 0.0);
+        }
+    }
+    return A;
+}
+
+int main() {
+    std::cout << "n,bandwidth,banded_us,banded_per_row_ns,banded_solve_us,sparse_us,sparse_solve_us" << std::endl;
+    for (unsigned int k: {1, 2, 5}) {
+        for (unsigned int n: {1000, 10000, 100000}) {
+            BandedMatrix A = testMatrix(n, k);
+            BandedLU banded;
+            double factorize = timeMicroseconds([&]() { banded.factorize(A); });
+            std::vector<double> b(n, 1.0);
+            double solve = timeMicroseconds([&]() { banded.solve(b); });
+
+            // SparseLU does not pivot, so it factors the diagonally dominant matrix A + 2k I with the same pattern
+            std::vector<Triplet> triplets;
+            for (unsigned int i = 0; i < n; i++) {
+                for (unsigned int j = i > k ? i - k : 0; j < std::min(n, i + k + 1); j++) {
+                    triplets.push_back({i, j, A(i, j) + (i == j ? 2.0 * k : 0.0)});
+                }
+            }
+            CSRMatrix S = CSRMatrix::fromTriplets(n, n, triplets);
+            SparseLU sparse(SparseLU::Ordering::Natural);
+            sparse.analyze(S);
+            double sparseFactorize = timeMicroseconds([&]() { sparse.factorize(S); });
+            double sparseSolve = timeMicroseconds([&]() { sparse.solve(b); });
+            std::cout << n << "," << k << "," << factorize << "," << 1e3 * factorize / n << "," << solve << ","
+                      << sparseFactorize << "," << sparseSolve << std::endl;
+        }
+    }
+}
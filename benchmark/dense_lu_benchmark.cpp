@@ -0,0 +1,67 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "../src/DenseLU.h"
+
+/**
+ * @brief Textbook LU factorization with partial pivoting as a triple loop, used as the baseline.
+ */
+void naiveLU(std::vector<double>& a, std::vector<unsigned int>& pivots, unsigned int n) {
+    pivots.resize(n);
+    for (unsigned int k = 0; k < n; k++) {
+        unsigned int p = k;
+        for (unsigned int i = k + 1; i < n; i++) {
+            if (std::abs(a[i * n + k]) > std::abs(a[p * n + k])) {
+                p = i;
+            }
+        }
+        pivots[k] = p;
+        for (unsigned int j = 0; j < n; j++) {
+            std::swap(a[k * n + j], a[p * n + j]);
+        }
+        for (unsigned int i = k + 1; i < n; i++) {
+            a[i * n + k] /= a[k * n + k];
+            for (unsigned int j = k + 1; j < n; j++) {
+                a[i * n + j] -= a[i * n + k] * a[k * n + j];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Runs the callable repeatedly for at least 0.2 seconds and returns the mean time in microseconds.
+ */
+template<typename Callable>
+double timeMicroseconds(Callable&& callable) {
+    auto start = std::chrono::steady_clock::now();
+    unsigned int repetitions = 0;
+    double elapsed = 0.0;
+    do {
+        callable();
+        repetitions++;
+        elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    } while (elapsed < 2e5);
+    return elapsed / repetitions;
+}
+
+int main() {
+    std::cout << "n,naive_us,blocked_us,speedup,solve_us" << std::endl;
+    for (unsigned int n: {20, 50, 100, 200, 500}) {
+        std::vector<double> A(n * n);
+        for (unsigned int i = 0; i < n * n; i++) {
+            A[i] = sin(1.0 + i) + (i % (n + 1) == 0 ? n : 0);
+        }
+        std::vector<double> work;
+        std::vector<unsigned int> pivots;
+        double naive = timeMicroseconds([&]() {
+            work = A;
+            naiveLU(work, pivots, n);
+        });
+        DenseLU lu;
+        double blocked = timeMicroseconds([&]() { lu.factorize(A, n); });
+        std::vector<double> b(n, 1.0);
+        double solve = timeMicroseconds([&]() { lu.solve(b); });
+        std::cout << n << "," << naive << "," << blocked << "," << naive / blocked << "," << solve << std::endl;
+    }
+}
@@ -0,0 +1,36 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/SDESolver.h"
+
+/**
+ * @brief Monte Carlo estimate of E[y(1)] of geometric Brownian motion, 10^7 paths by default or argv[1] paths.
+ */
+int main(int argc, char** argv) {
+    const std::uint64_t paths = argc > 1 ? std::stoull(argv[1]) : 10000000;
+    const double mu = 0.05, sigma = 0.2;
+    auto f = [mu](double y, double t) { return mu * y; };
+    auto g = [sigma](double y, double t) { return sigma * y; };
+    auto dg = [sigma](double y, double t) { return sigma; };
+    std::cout << "method,threads,paths,seconds,paths_per_second,mean,exact" << std::endl;
+    for (auto [name, method]: {std::make_pair("EulerMaruyama", SDESolver::Method::EulerMaruyama),
+                               std::make_pair("Milstein", SDESolver::Method::Milstein)}) {
+        SDESolver solver(f, g, 1.0, 0.0, method, 1, dg);
+        for (unsigned int threads: {1u, std::max(1u, std::thread::hardware_concurrency())}) {
+            auto pool = std::make_shared<ThreadPool>(threads);
+            auto start = std::chrono::steady_clock::now();
+            std::vector<double> y = solver.terminalValues(1.0 / 32, 1.0, paths, pool);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            double mean = 0.0;
+            for (double value: y) {
+                mean += value / paths;
+            }
+            std::cout << name << "," << threads << "," << paths << "," << seconds << "," << paths / seconds << ","
+                      << mean << "," << exp(mu) << std::endl;
+        }
+    }
+}
@@ -8,9 +8,15 @@ std::vector<double> AdamsBashforthTwo::solve(double stepSize, double tEnd) {
     y.push_back(y0);
     y.push_back(y0 + stepSize / 2 * (f(y0 + stepSize * f(y0, t0), t0 + stepSize) + f(y0, t0))); // heun method for first step
     //y.push_back(y0 + stepSize*f(y0,y0)); // euler method for first step
+    if (events && stopAtEvent(y, t0, t0 + stepSize)) {
+        return y;
+    }
     for (int n = 2; n < N; n++) {
         t = t0 + n * stepSize;
         y.push_back(y.back() + stepSize * (3/2*f(y.back(), t - stepSize) - 1/2*f(y[n - 2], t - 2*stepSize)));
+        if (events && stopAtEvent(y, t0 + (n - 1) * stepSize, t0 + n * stepSize)) {
+            break;
+        }
     }
     return y;
 }
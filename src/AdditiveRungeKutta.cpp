@@ -0,0 +1,120 @@
+#include "AdditiveRungeKutta.h"
+#include <stdexcept>
+
+void AdditiveRungeKutta::setTables(Method method) {
+    if (method == Method::ARK3) {
+        const double gamma = 1767732205903.0 / 4055673282236.0;
+        stages = 4;
+        explicitA = {
+                0, 0, 0, 0,
+                1767732205903.0 / 2027836641118.0, 0, 0, 0,
+                5535828885825.0 / 10492691773637.0, 788022342437.0 / 10882634858940.0, 0, 0,
+                6485989280629.0 / 16251701735622.0, -4246266847089.0 / 9704473918619.0,
+                10755448449292.0 / 10357097424841.0, 0
+        };
+        b = {1471266399579.0 / 7840856788654.0, -4482444167858.0 / 7529755066697.0,
+             11266239266428.0 / 11593286722821.0, gamma};
+        implicitA = {
+                0, 0, 0, 0,
+                gamma, gamma, 0, 0,
+                2746238789719.0 / 10658868560708.0, -640167445237.0 / 6845629431997.0, gamma, 0,
+                b[0], b[1], b[2], gamma
+        };
+        c = {0, 2 * gamma, 3.0 / 5.0, 1};
+    } else {
+        const double gamma = 1.0 / 4.0;
+        stages = 6;
+        explicitA = {
+                0, 0, 0, 0, 0, 0,
+                1.0 / 2.0, 0, 0, 0, 0, 0,
+                13861.0 / 62500.0, 6889.0 / 62500.0, 0, 0, 0, 0,
+                -116923316275.0 / 2393684061468.0, -2731218467317.0 / 15368042101831.0,
+                9408046702089.0 / 11113171139209.0, 0, 0, 0,
+                -451086348788.0 / 2902428689909.0, -2682348792572.0 / 7519795681897.0,
+                12662868775082.0 / 11960479115383.0, 3355817975965.0 / 11060851509271.0, 0, 0,
+                647845179188.0 / 3216320057751.0, 73281519250.0 / 8382639484533.0,
+                552539513391.0 / 3454668386233.0, 3354512671639.0 / 8306763924573.0, 4040.0 / 17871.0, 0
+        };
+        b = {82889.0 / 524892.0, 0, 15625.0 / 83664.0, 69875.0 / 102672.0, -2260.0 / 8211.0, gamma};
+        implicitA = {
+                0, 0, 0, 0, 0, 0,
+                gamma, gamma, 0, 0, 0, 0,
+                8611.0 / 62500.0, -1743.0 / 31250.0, gamma, 0, 0, 0,
+                5012029.0 / 34652500.0, -654441.0 / 2922500.0, 174375.0 / 388108.0, gamma, 0, 0,
+                15267082809.0 / 155376265600.0, -71443401.0 / 120774400.0, 730878875.0 / 902184768.0,
+                2285395.0 / 8070912.0, gamma, 0,
+                b[0], b[1], b[2], b[3], b[4], gamma
+        };
+        c = {0, 1.0 / 2.0, 83.0 / 250.0, 31.0 / 50.0, 17.0 / 20.0, 1};
+    }
+}
+
+std::vector<std::vector<double>> AdditiveRungeKutta::solve(double stepSize, double tEnd) {
+    if (mass || parameterJacobian) {
+        throw std::invalid_argument("AdditiveRungeKutta does not support mass matrices or sensitivities");
+    }
+    double t = t0;
+    unsigned int N = ceil((tEnd - t0) / stepSize) + 1;
+    const unsigned int n = y0.size();
+    std::vector<std::vector<double>> y;
+    y.reserve(N);
+    y.push_back(y0);
+    const SystemFunction rhs = events ? full() : nullptr;
+    std::vector<std::vector<double>> kExplicit(stages, std::vector<double>(n));
+    std::vector<std::vector<double>> kImplicit(stages, std::vector<double>(n));
+    std::vector<double> base(n), stage(n);
+    for (int k = 1; k < N; k++) {
+        const std::vector<double>& u = y.back();
+        stage = u;
+        bool converged = true;
+        for (unsigned int i = 0; i < stages && converged; i++) {
+            double tStage = t + c[i] * stepSize;
+            if (i > 0) {
+                base = u;
+                for (unsigned int j = 0; j < i; j++) {
+                    double ae = stepSize * explicitA[i * stages + j];
+                    double ai = stepSize * implicitA[i * stages + j];
+                    for (unsigned int l = 0; l < n; l++) {
+                        base[l] += ae * kExplicit[j][l] + ai * kImplicit[j][l];
+                    }
+                }
+                // The previous stage is the Newton initial guess
+                converged = Newton(stage, base, tStage, stepSize * implicitA[i * stages + i]);
+            }
+            fExplicit(stage, tStage, kExplicit[i]);
+            f(stage, tStage, kImplicit[i]);
+        }
+        if (!converged) {
+            std::cout << "Newton method did not converge" << std::endl;
+            break;
+        }
+        std::vector<double> y_new = u;
+        for (unsigned int i = 0; i < stages; i++) {
+            for (unsigned int l = 0; l < n; l++) {
+                y_new[l] += stepSize * b[i] * (kExplicit[i][l] + kImplicit[i][l]);
+            }
+        }
+        y.push_back(std::move(y_new));
+        if (events && stopAtEvent(y, t0 + (k - 1) * stepSize, t0 + k * stepSize, rhs)) {
+            break;
+        }
+        t = t0 + k * stepSize;
+    }
+    return y;
+}
+
+SystemFunction AdditiveRungeKutta::full() const {
+    return [this, stiff = std::vector<double>()](const std::vector<double>& y, double t,
+                                                 std::vector<double>& dydt) mutable {
+        stiff.resize(y.size());
+        fExplicit(y, t, dydt);
+        f(y, t, stiff);
+        for (unsigned int i = 0; i < y.size(); i++) {
+            dydt[i] += stiff[i];
+        }
+    };
+}
+
+DenseOutput AdditiveRungeKutta::solveDense(double stepSize, double tEnd, DenseOutput::Order order) {
+    return DenseOutput::fromFunction(full(), t0, stepSize, solve(stepSize, tEnd), order);
+}
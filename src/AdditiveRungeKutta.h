@@ -0,0 +1,84 @@
+#pragma once
+
+#include "ImplicitSystemSolver.h"
+#include <utility>
+#include <vector>
+#include <iostream>
+#include <cmath>
+
+/**
+ * @brief Class for solving split systems y' = f_E(y, t) + f_I(y, t) with implicit-explicit (IMEX) additive
+ * Runge-Kutta methods of Kennedy and Carpenter (2003).
+ *
+ * The non-stiff part f_E is treated explicitly, only the stiff part f_I goes through the Newton iterations of
+ * ImplicitSystemSolver, so the Jacobian (or the linear solver) only refers to f_I. The implicit tables are
+ * ESDIRK with a constant diagonal, so a factorized Newton matrix is shared by all stages and steps.
+ */
+class AdditiveRungeKutta : public ImplicitSystemSolver {
+
+public:
+    enum class Method {
+        ARK3,  // ARK3(2)4L[2]SA, third order with four stages
+        ARK4   // ARK4(3)6L[2]SA, fourth order with six stages
+    };
+
+    /**
+     * @brief Construct an AdditiveRungeKutta object using the dense linear solver
+     *
+     * @param  fExplicit  Non-stiff part of y' = fExplicit(y, t) + fImplicit(y, t)
+     * @param  fImplicit  Stiff part of y' = fExplicit(y, t) + fImplicit(y, t)
+     * @param         y0  Initial value of y
+     * @param         t0  Initial value of t
+     * @param   jacobian  Such that jacobian(y, t) = dfImplicit(y, t)/dy
+     * @param     method  Pair of Butcher tables
+     */
+    AdditiveRungeKutta(SystemFunction fExplicit, SystemFunction fImplicit, std::vector<double> y0, double t0,
+                       DenseJacobianFunction jacobian, Method method = Method::ARK4)
+            : ImplicitSystemSolver(std::move(fImplicit), std::move(y0), t0, std::move(jacobian)),
+              fExplicit(std::move(fExplicit)) { setTables(method); }
+
+    /**
+     * @brief Construct an AdditiveRungeKutta object
+     *
+     * @param     fExplicit  Non-stiff part of y' = fExplicit(y, t) + fImplicit(y, t)
+     * @param     fImplicit  Stiff part of y' = fExplicit(y, t) + fImplicit(y, t)
+     * @param            y0  Initial value of y
+     * @param            t0  Initial value of t
+     * @param  linearSolver  Solver for the Newton systems of fImplicit
+     * @param        method  Pair of Butcher tables
+     */
+    AdditiveRungeKutta(SystemFunction fExplicit, SystemFunction fImplicit, std::vector<double> y0, double t0,
+                       std::unique_ptr<LinearSolver> linearSolver, Method method = Method::ARK4)
+            : ImplicitSystemSolver(std::move(fImplicit), std::move(y0), t0, std::move(linearSolver)),
+              fExplicit(std::move(fExplicit)) { setTables(method); }
+
+    /**
+     * @brief Solves the system of ODEs using the additive Runge-Kutta method.
+     * @param stepSize The step size.
+     * @param tEnd The time to solve the ODE to.
+     * @return A vector of the solution vector at each step.
+     */
+    std::vector<std::vector<double>> solve(double stepSize, double tEnd) override;
+
+    /**
+     * @brief Dense output with y' = fExplicit(y, t) + fImplicit(y, t) at the steps.
+     */
+    DenseOutput solveDense(double stepSize, double tEnd,
+                           DenseOutput::Order order = DenseOutput::Order::Cubic) override;
+
+private:
+    SystemFunction fExplicit;
+    // Butcher tables, row-major s x s
+    std::vector<double> explicitA;
+    std::vector<double> implicitA;
+    std::vector<double> b;
+    std::vector<double> c;
+    unsigned int stages = 0;
+
+    void setTables(Method method);
+
+    /**
+     * @brief y' = fExplicit(y, t) + fImplicit(y, t), for events and dense output.
+     */
+    SystemFunction full() const;
+};
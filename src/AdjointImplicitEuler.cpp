@@ -0,0 +1,145 @@
+#include "AdjointImplicitEuler.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+AdjointImplicitEuler::AdjointImplicitEuler(SystemFunction f, DenseJacobianFunction jacobian,
+                                           ParameterAdjointFunction dfdp, unsigned int parameters,
+                                           std::vector<double> y0, double t0, unsigned int checkpoints)
+        : f(std::move(f)), jacobian(std::move(jacobian)), dfdp(std::move(dfdp)), parameters(parameters),
+          y0(std::move(y0)), t0(t0), checkpoints(checkpoints) {
+    if (checkpoints == 0) {
+        throw std::invalid_argument("The adjoint needs at least one checkpoint");
+    }
+}
+
+double AdjointImplicitEuler::binomialSteps(unsigned int c, unsigned int r) {
+    double steps = 1.0;
+    for (unsigned int k = 1; k <= c; k++) {
+        steps = steps * (r + k) / k;
+    }
+    return steps;
+}
+
+std::vector<double> AdjointImplicitEuler::forward(const std::vector<double>& y, unsigned long n) {
+    const unsigned int dim = y.size();
+    const double t = t0 + (n + 1) * h;
+    std::vector<double> x = y;
+    residual.resize(dim);
+    stats.forwardSteps++;
+    for (unsigned int iteration = 0; iteration < 50; iteration++) {
+        f(x, t, residual);
+        for (unsigned int i = 0; i < dim; i++) {
+            residual[i] = y[i] + h * residual[i] - x[i];
+        }
+        matrix.assign(static_cast<std::size_t>(dim) * dim, 0.0);
+        jacobian(x, t, matrix);
+        for (unsigned int k = 0; k < matrix.size(); k++) {
+            matrix[k] *= -h;
+        }
+        for (unsigned int i = 0; i < dim; i++) {
+            matrix[i * dim + i] += 1.0;
+        }
+        lu.factorize(matrix, dim);
+        lu.solve(residual);
+        double norm = 0.0;
+        double scale = 0.0;
+        for (unsigned int i = 0; i < dim; i++) {
+            x[i] += residual[i];
+            norm = std::max(norm, std::abs(residual[i]));
+            scale = std::max(scale, std::abs(x[i]));
+        }
+        if (norm <= 1e-12 * (1 + scale)) {
+            return x;
+        }
+    }
+    throw std::runtime_error("Newton method did not converge");
+}
+
+std::vector<double> AdjointImplicitEuler::advance(std::vector<double> y, unsigned long a, unsigned long b) {
+    for (unsigned long n = a; n < b; n++) {
+        y = forward(y, n);
+    }
+    return y;
+}
+
+void AdjointImplicitEuler::adjointStep(const std::vector<double>& y, unsigned long n) {
+    const unsigned int dim = y.size();
+    const double t = t0 + (n + 1) * h;
+    if (n + 1 == steps) {
+        result.yEnd = y;
+        lambda = (*objective)(y);
+    }
+    // (I - h J)^T is assembled transposed and factorized as it is
+    matrix.assign(static_cast<std::size_t>(dim) * dim, 0.0);
+    jacobian(y, t, matrix);
+    for (unsigned int i = 0; i < dim; i++) {
+        for (unsigned int j = i; j < dim; j++) {
+            double upper = -h * matrix[i * dim + j];
+            matrix[i * dim + j] = -h * matrix[j * dim + i];
+            matrix[j * dim + i] = upper;
+        }
+        matrix[i * dim + i] += 1.0;
+    }
+    lu.factorize(matrix, dim);
+    lu.solve(lambda);
+    std::vector<double> scaled(dim);
+    for (unsigned int i = 0; i < dim; i++) {
+        scaled[i] = h * lambda[i];
+    }
+    dfdp(y, t, scaled, result.gradient);
+    stats.adjointSteps++;
+}
+
+void AdjointImplicitEuler::reverse(unsigned long a, unsigned long b, unsigned int s) {
+    if (b - a == 1) {
+        adjointStep(forward(stored.back(), a), a);
+        return;
+    }
+    if (s == 0) {
+        // No free checkpoint, every step is recomputed from a
+        for (unsigned long n = b; n-- > a;) {
+            adjointStep(forward(advance(stored.back(), a, n), n), n);
+        }
+        return;
+    }
+    // Smallest number of recomputations r that covers the steps, the left part gets s checkpoints and r - 1
+    // recomputations, the right part s - 1 checkpoints and r recomputations
+    const unsigned long l = b - a;
+    unsigned int r = 1;
+    while (binomialSteps(s, r) < l) {
+        r++;
+    }
+    const double right = binomialSteps(s - 1, r);
+    const unsigned long left = l > right ? l - static_cast<unsigned long>(right) : 1;
+    const unsigned long m = a + std::min(std::max(left, 1ul), l - 1);
+    stored.push_back(advance(stored.back(), a, m));
+    stats.maxCheckpoints = std::max<unsigned int>(stats.maxCheckpoints, stored.size());
+    reverse(m, b, s - 1);
+    stored.pop_back();
+    reverse(a, m, s);
+}
+
+AdjointImplicitEuler::Result
+AdjointImplicitEuler::gradient(const std::function<std::vector<double>(const std::vector<double>& y)>& dgdy,
+                               double stepSize, double tEnd) {
+    stats = Statistics();
+    unsigned int N = ceil((tEnd - t0) / stepSize) + 1;
+    result = Result();
+    result.gradient.assign(parameters, 0.0);
+    objective = &dgdy;
+    h = stepSize;
+    steps = N - 1;
+    stored.assign(1, y0);
+    stats.maxCheckpoints = 1;
+    if (steps == 0) {
+        result.yEnd = y0;
+        result.initialGradient = dgdy(y0);
+        return result;
+    }
+    reverse(0, steps, checkpoints - 1);
+    result.initialGradient = lambda;
+    stored.clear();
+    objective = nullptr;
+    return result;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include "ODESystemSolver.h"
+#include "DenseLinearSolver.h"
+#include "DenseLU.h"
+
+/**
+ * @brief Transposed parameter derivative, adds lambda^T df(y, t)/dp to grad without forming df/dp.
+ */
+using ParameterAdjointFunction = std::function<void(const std::vector<double>& y, double t,
+                                                    const std::vector<double>& lambda, std::vector<double>& grad)>;
+
+/**
+ * @brief Gradient of an objective g(y(tEnd)) with respect to many parameters of f and to y0, by the discrete adjoint of
+ * the implicit Euler method.
+ *
+ * The adjoint of a step y_{n+1} = y_n + h f(y_{n+1}, t_{n+1}) is (I - h J_{n+1})^T mu = lambda_{n+1}, lambda_n = mu,
+ * and the gradient collects h mu^T df/dp, so one backward sweep gives the gradient for all parameters. The sweep needs
+ * the states in reverse order. Only a given number of them is stored at a time: the steps between the checkpoints are
+ * recomputed with Griewank's binomial (revolve) schedule, which for c checkpoints and r recomputations covers
+ * (c + r)! / (c! r!) steps. The forward steps use a full Newton method started from the previous state, so a
+ * recomputed state is bitwise the same as in the first forward sweep.
+ */
+class AdjointImplicitEuler {
+
+public:
+    /**
+     * @brief Work and memory of the last gradient.
+     *
+     * @param forwardSteps    Number of forward steps including the recomputations
+     * @param adjointSteps    Number of adjoint steps
+     * @param maxCheckpoints  Largest number of states stored at a time
+     */
+    struct Statistics {
+        unsigned long forwardSteps = 0;
+        unsigned long adjointSteps = 0;
+        unsigned int maxCheckpoints = 0;
+    };
+
+    /**
+     * @brief Final state and gradients.
+     *
+     * @param yEnd             The solution at tEnd
+     * @param gradient         dg/dp
+     * @param initialGradient  dg/dy0
+     */
+    struct Result {
+        std::vector<double> yEnd;
+        std::vector<double> gradient;
+        std::vector<double> initialGradient;
+    };
+
+    /**
+     * @brief Construct an AdjointImplicitEuler object
+     *
+     * @param            f  Such that y' = f(y, t)
+     * @param     jacobian  Such that jacobian(y, t) = df(y, t)/dy
+     * @param         dfdp  Adds lambda^T df(y, t)/dp to its last argument
+     * @param   parameters  Number of parameters
+     * @param           y0  Initial value of y
+     * @param           t0  Initial value of t
+     * @param  checkpoints  Maximum number of states stored at a time, at least 1
+     */
+    AdjointImplicitEuler(SystemFunction f, DenseJacobianFunction jacobian, ParameterAdjointFunction dfdp,
+                         unsigned int parameters, std::vector<double> y0, double t0, unsigned int checkpoints);
+
+    /**
+     * @brief Solves to tEnd and computes the gradient of g(y(tEnd)).
+     * @param dgdy     Gradient of the objective with respect to y(tEnd)
+     * @param stepSize The step size.
+     * @param tEnd     The time to solve the ODE to.
+     */
+    Result gradient(const std::function<std::vector<double>(const std::vector<double>& y)>& dgdy, double stepSize,
+                    double tEnd);
+
+    const Statistics& statistics() const { return stats; }
+
+    /**
+     * @brief Number of steps the binomial schedule covers with c checkpoints and r recomputations, (c + r)! / (c! r!).
+     */
+    static double binomialSteps(unsigned int c, unsigned int r);
+
+private:
+    SystemFunction f;
+    DenseJacobianFunction jacobian;
+    ParameterAdjointFunction dfdp;
+    unsigned int parameters;
+    std::vector<double> y0;
+    double t0;
+    unsigned int checkpoints;
+    Statistics stats;
+
+    // State of the current gradient
+    const std::function<std::vector<double>(const std::vector<double>& y)>* objective = nullptr;
+    double h = 0.0;
+    unsigned long steps = 0;
+    std::vector<std::vector<double>> stored;
+    std::vector<double> lambda;
+    Result result;
+    std::vector<double> matrix, residual;
+    DenseLU lu;
+
+    /**
+     * @brief One implicit Euler step from y at step n, solved with a full Newton method.
+     */
+    std::vector<double> forward(const std::vector<double>& y, unsigned long n);
+
+    /**
+     * @brief Advances y from step a to step b.
+     */
+    std::vector<double> advance(std::vector<double> y, unsigned long a, unsigned long b);
+
+    /**
+     * @brief Adjoint of step n, given the state y after it.
+     */
+    void adjointStep(const std::vector<double>& y, unsigned long n);
+
+    /**
+     * @brief Runs the adjoint over the steps a, ..., b - 1 in reverse, with the state at a on top of stored and s
+     * free checkpoints.
+     */
+    void reverse(unsigned long a, unsigned long b, unsigned int s);
+};
@@ -0,0 +1,83 @@
+#include "BandedLU.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+void BandedLU::factorize(const BandedMatrix& A) {
+    if (A.values.size() != static_cast<std::size_t>(A.n) * A.width()) {
+        throw std::invalid_argument("Band storage does not match the dimension and bandwidths");
+    }
+    const unsigned int n = A.n;
+    const unsigned int kl = A.kl;
+    const unsigned int ku = A.kl + A.ku;
+    // Reuses the storage of the previous factorization
+    lu.n = n;
+    lu.kl = kl;
+    lu.ku = ku;
+    const unsigned int width = lu.width();
+    lu.values.assign(static_cast<std::size_t>(n) * width, 0.0);
+    for (unsigned int i = 0; i < n; i++) {
+        std::copy_n(A.values.begin() + static_cast<std::size_t>(i) * A.width(), A.width(),
+                    lu.values.begin() + static_cast<std::size_t>(i) * width);
+    }
+    pivots.resize(n);
+
+    for (unsigned int k = 0; k < n; k++) {
+        const unsigned int iEnd = std::min(n, k + kl + 1);
+        const unsigned int jEnd = std::min(n, k + ku + 1);
+        unsigned int p = k;
+        for (unsigned int i = k + 1; i < iEnd; i++) {
+            if (std::abs(lu(i, k)) > std::abs(lu(p, k))) {
+                p = i;
+            }
+        }
+        if (lu(p, k) == 0.0) {
+            throw std::runtime_error("Singular matrix in banded LU factorization");
+        }
+        pivots[k] = p;
+        // Rows k and p only have entries in columns [k, jEnd) left, both lie in the widened band
+        if (p != k) {
+            for (unsigned int j = k; j < jEnd; j++) {
+                std::swap(lu(k, j), lu(p, j));
+            }
+        }
+        const double* __restrict pivotRow = &lu(k, k);
+        const double pivot = pivotRow[0];
+        for (unsigned int i = k + 1; i < iEnd; i++) {
+            double* __restrict row = &lu(i, k);
+            double l = row[0] / pivot;
+            row[0] = l;
+            if (l == 0.0) {
+                continue;
+            }
+            for (unsigned int j = 1; j < jEnd - k; j++) {
+                row[j] -= l * pivotRow[j];
+            }
+        }
+    }
+}
+
+void BandedLU::solve(std::vector<double>& b) const {
+    const unsigned int n = lu.n;
+    if (b.size() != n) {
+        throw std::invalid_argument("Right hand side does not match the factorized matrix");
+    }
+    // L y = P b, with the interchanges and eliminations in the order of the factorization
+    for (unsigned int k = 0; k < n; k++) {
+        std::swap(b[k], b[pivots[k]]);
+        const unsigned int iEnd = std::min(n, k + lu.kl + 1);
+        for (unsigned int i = k + 1; i < iEnd; i++) {
+            b[i] -= lu(i, k) * b[k];
+        }
+    }
+    // U x = y
+    for (unsigned int i = n; i-- > 0;) {
+        const unsigned int jEnd = std::min(n, i + lu.ku + 1);
+        const double* row = lu.values.data() + static_cast<std::size_t>(i) * lu.width() + lu.kl;
+        double sum = b[i];
+        for (unsigned int j = 1; j < jEnd - i; j++) {
+            sum -= row[j] * b[i + j];
+        }
+        b[i] = sum / row[0];
+    }
+}
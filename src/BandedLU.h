@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+#include "BandedMatrix.h"
+
+/**
+ * @brief LU factorization with partial pivoting of a band matrix, P A = L U, in O(n kl (kl + ku)) operations.
+ *
+ * Row interchanges let the upper bandwidth of U grow to kl + ku, so the factors are kept in a BandedMatrix with
+ * kl subdiagonals and kl + ku superdiagonals (as in LAPACK's gbtrf). L is stored unpermuted below the diagonal,
+ * the interchanges are applied to the right hand side in the order they were made. All row operations run over
+ * contiguous parts of the band rows.
+ */
+class BandedLU {
+
+public:
+    /**
+     * @brief Computes the factorization of A.
+     * @param A Band matrix.
+     */
+    void factorize(const BandedMatrix& A);
+
+    /**
+     * @brief Solves A x = b with the current factorization.
+     * @param b Right hand side, overwritten with the solution.
+     */
+    void solve(std::vector<double>& b) const;
+
+    /**
+     * @brief Dimension of the factorized matrix.
+     */
+    unsigned int size() const { return lu.n; }
+
+private:
+    BandedMatrix lu;
+    std::vector<unsigned int> pivots;
+};
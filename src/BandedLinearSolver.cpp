@@ -0,0 +1,36 @@
+#include "BandedLinearSolver.h"
+#include <algorithm>
+#include <stdexcept>
+
+void BandedLinearSolver::setup(const std::vector<double>& y, double t, double gamma) {
+    unsigned int n = y.size();
+    if (matrix.n != n) {
+        matrix = BandedMatrix(n, kl, ku);
+    } else {
+        std::fill(matrix.values.begin(), matrix.values.end(), 0.0);
+    }
+    jacobian(y, t, matrix);
+    for (double& entry: matrix.values) {
+        entry *= -gamma;
+    }
+    if (mass) {
+        mass(y, t, M);
+        for (unsigned int i = 0; i < n; i++) {
+            for (unsigned int p = M.rowPtr[i]; p < M.rowPtr[i + 1]; p++) {
+                if (!matrix.inBand(i, M.colIdx[p])) {
+                    throw std::invalid_argument("Mass matrix entry outside of the band of the Jacobian");
+                }
+                matrix(i, M.colIdx[p]) += M.values[p];
+            }
+        }
+    } else {
+        for (unsigned int i = 0; i < n; i++) {
+            matrix(i, i) += 1.0;
+        }
+    }
+    lu.factorize(matrix);
+}
+
+void BandedLinearSolver::solve(std::vector<double>& b) {
+    lu.solve(b);
+}
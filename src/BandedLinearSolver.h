@@ -0,0 +1,45 @@
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include "LinearSolver.h"
+#include "BandedMatrix.h"
+#include "BandedLU.h"
+
+/**
+ * @brief Solves the Newton systems with a band Jacobian and BandedLU.
+ *
+ * Setup and solve cost O(n kl (kl + ku)) and O(n (kl + ku)), i.e. they grow linearly in n for a fixed bandwidth,
+ * which makes this the solver of choice for 1D discretizations and other chain-like couplings.
+ */
+class BandedLinearSolver : public LinearSolver {
+
+public:
+    /**
+     * @brief Construct a BandedLinearSolver object
+     *
+     * @param jacobian  Such that jacobian(y, t) = df(y, t)/dy
+     * @param       kl  Number of subdiagonals of the Jacobian
+     * @param       ku  Number of superdiagonals of the Jacobian
+     */
+    BandedLinearSolver(BandedJacobianFunction jacobian, unsigned int kl, unsigned int ku)
+            : jacobian(std::move(jacobian)), kl(kl), ku(ku) {}
+
+    void setup(const std::vector<double>& y, double t, double gamma) override;
+
+    void solve(std::vector<double>& b) override;
+
+    using LinearSolver::solve;
+
+    void setMassMatrix(MassMatrixFunction mass) override { this->mass = std::move(mass); }
+
+private:
+    MassMatrixFunction mass;
+    CSRMatrix M;
+    BandedJacobianFunction jacobian;
+    unsigned int kl;
+    unsigned int ku;
+    BandedMatrix matrix;
+    BandedLU lu;
+};
@@ -0,0 +1,16 @@
+#include "BandedMatrix.h"
+#include <algorithm>
+
+void BandedMatrix::multiply(const std::vector<double>& x, std::vector<double>& y) const {
+    y.assign(n, 0.0);
+    for (unsigned int i = 0; i < n; i++) {
+        unsigned int jBegin = i > kl ? i - kl : 0;
+        unsigned int jEnd = std::min(n, i + ku + 1);
+        const double* row = values.data() + static_cast<std::size_t>(i) * width() + kl - i;
+        double sum = 0.0;
+        for (unsigned int j = jBegin; j < jEnd; j++) {
+            sum += row[j] * x[j];
+        }
+        y[i] = sum;
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Square band matrix with lower bandwidth kl and upper bandwidth ku.
+ *
+ * The band is stored row by row, entry (i, j) with -kl <= j - i <= ku at values[i * width() + j - i + kl], so the
+ * storage is n * (kl + ku + 1) and the band of a row is contiguous. Positions outside the matrix in the first and
+ * last rows are stored but never used.
+ */
+struct BandedMatrix {
+    unsigned int n = 0;
+    unsigned int kl = 0;
+    unsigned int ku = 0;
+    std::vector<double> values;
+
+    BandedMatrix() = default;
+
+    /**
+     * @brief Creates a zero band matrix.
+     *
+     * @param n   Dimension
+     * @param kl  Number of subdiagonals
+     * @param ku  Number of superdiagonals
+     */
+    BandedMatrix(unsigned int n, unsigned int kl, unsigned int ku)
+            : n(n), kl(kl), ku(ku), values(static_cast<std::size_t>(n) * (kl + ku + 1), 0.0) {}
+
+    /**
+     * @brief Number of stored entries per row.
+     */
+    unsigned int width() const { return kl + ku + 1; }
+
+    /**
+     * @brief Whether entry (i, j) lies inside the band.
+     */
+    bool inBand(unsigned int i, unsigned int j) const { return j + kl >= i && j <= i + ku; }
+
+    /**
+     * @brief Entry (i, j), which must lie inside the band.
+     */
+    double& operator()(unsigned int i, unsigned int j) { return values[i * width() + j + kl - i]; }
+
+    double operator()(unsigned int i, unsigned int j) const { return values[i * width() + j + kl - i]; }
+
+    /**
+     * @brief Computes y = A * x.
+     */
+    void multiply(const std::vector<double>& x, std::vector<double>& y) const;
+};
+
+/**
+ * @brief Jacobian of a system of ODEs in band storage, writes df(y, t)/dy into J.
+ *
+ * J is zeroed and has the bandwidths given to the solver, entries outside the band must be zero.
+ */
+using BandedJacobianFunction = std::function<void(const std::vector<double>& y, double t, BandedMatrix& J)>;
@@ -0,0 +1,37 @@
+#include "BlockJacobiPreconditioner.h"
+#include <algorithm>
+#include <stdexcept>
+
+void BlockJacobiPreconditioner::setup(const std::vector<double>& y, double t, double gamma) {
+    if (blockSize == 0) {
+        throw std::invalid_argument("Block size must be positive");
+    }
+    jacobian(y, t, J);
+    const CSRMatrix& M = newtonMatrix.assemble(J, gamma);
+    const unsigned int n = M.rows;
+    blocks.resize((n + blockSize - 1) / blockSize);
+    for (unsigned int b = 0; b < blocks.size(); b++) {
+        unsigned int begin = b * blockSize;
+        unsigned int size = std::min(blockSize, n - begin);
+        block.assign(size * size, 0.0);
+        for (unsigned int i = 0; i < size; i++) {
+            unsigned int row = begin + i;
+            for (unsigned int p = M.rowPtr[row]; p < M.rowPtr[row + 1]; p++) {
+                unsigned int col = M.colIdx[p];
+                if (col >= begin && col < begin + size) {
+                    block[i * size + col - begin] = M.values[p];
+                }
+            }
+        }
+        blocks[b].factorize(block, size);
+    }
+}
+
+void BlockJacobiPreconditioner::apply(std::vector<double>& v) {
+    for (unsigned int b = 0; b < blocks.size(); b++) {
+        unsigned int begin = b * blockSize;
+        segment.assign(v.begin() + begin, v.begin() + begin + blocks[b].size());
+        blocks[b].solve(segment);
+        std::copy(segment.begin(), segment.end(), v.begin() + begin);
+    }
+}
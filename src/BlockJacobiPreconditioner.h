@@ -0,0 +1,39 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+#include "Preconditioner.h"
+#include "SparseNewtonMatrix.h"
+#include "DenseLU.h"
+
+/**
+ * @brief Block-Jacobi preconditioner of the Newton matrix I - gamma * J with a sparse Jacobian.
+ *
+ * The unknowns are split into consecutive blocks of a fixed size (the last block may be smaller). Every diagonal
+ * block of the Newton matrix is factorized densely, the coupling between blocks is ignored.
+ */
+class BlockJacobiPreconditioner : public Preconditioner {
+
+public:
+    /**
+     * @brief Construct a BlockJacobiPreconditioner object
+     *
+     * @param jacobian  Such that jacobian(y, t) = df(y, t)/dy
+     * @param blockSize Number of unknowns per block
+     */
+    BlockJacobiPreconditioner(SparseJacobianFunction jacobian, unsigned int blockSize)
+            : jacobian(std::move(jacobian)), blockSize(blockSize) {}
+
+    void setup(const std::vector<double>& y, double t, double gamma) override;
+
+    void apply(std::vector<double>& v) override;
+
+private:
+    SparseJacobianFunction jacobian;
+    unsigned int blockSize;
+    CSRMatrix J;
+    SparseNewtonMatrix newtonMatrix;
+    std::vector<DenseLU> blocks;
+    std::vector<double> block;
+    std::vector<double> segment;
+};
@@ -0,0 +1,137 @@
+#include "BulirschStoer.h"
+#include <algorithm>
+#include <future>
+#include <stdexcept>
+
+BulirschStoer::BulirschStoer(SystemFunction f, std::vector<double> y0, double t0, double tol, unsigned int maxColumns,
+                             std::shared_ptr<ThreadPool> pool)
+        : ODESystemSolver(std::move(f), std::move(y0), t0), tol(tol), maxColumns(maxColumns), pool(std::move(pool)) {
+    if (maxColumns < 3) {
+        throw std::invalid_argument("Bulirsch-Stoer needs at least 3 columns");
+    }
+}
+
+std::vector<double> BulirschStoer::midpoint(const std::vector<double>& y, const std::vector<double>& dydt, double t,
+                                            double H, unsigned int n) const {
+    const double h = H / n;
+    std::vector<double> previous = y;
+    std::vector<double> z(y.size());
+    std::vector<double> dz(y.size());
+    for (unsigned int i = 0; i < y.size(); i++) {
+        z[i] = y[i] + h * dydt[i];
+    }
+    for (unsigned int m = 1; m < n; m++) {
+        f(z, t + m * h, dz);
+        for (unsigned int i = 0; i < y.size(); i++) {
+            double next = previous[i] + 2 * h * dz[i];
+            previous[i] = z[i];
+            z[i] = next;
+        }
+    }
+    f(z, t + H, dz);
+    for (unsigned int i = 0; i < y.size(); i++) {
+        z[i] = (z[i] + previous[i] + h * dz[i]) / 2;
+    }
+    return z;
+}
+
+std::vector<std::vector<double>> BulirschStoer::solve(double stepSize, double tEnd) {
+    unsigned int N = ceil((tEnd - t0) / stepSize) + 1;
+    const unsigned int dim = y0.size();
+    stats = Statistics();
+    std::vector<std::vector<double>> y;
+    y.reserve(N);
+    y.push_back(y0);
+    std::vector<unsigned int> steps(maxColumns);
+    std::vector<double> work(maxColumns);
+    for (unsigned int j = 0; j < maxColumns; j++) {
+        steps[j] = 2 * (j + 1);
+        work[j] = (j == 0 ? 1 : work[j - 1]) + steps[j];
+    }
+    std::vector<double> current = y0;
+    std::vector<double> dydt(dim);
+    double t = t0;
+    double H = stepSize;
+    unsigned int kc = std::min(4u, maxColumns - 2);
+    for (int n = 1; n < N; n++) {
+        const double tGrid = t0 + n * stepSize;
+        while (tGrid - t > 1e-12 * std::max(1.0, std::abs(tGrid))) {
+            const double h = std::min(H, tGrid - t);
+            if (h < 1e-14 * std::max(1.0, std::abs(t))) {
+                throw std::runtime_error("Bulirsch-Stoer step size too small");
+            }
+            f(current, t, dydt);
+            stats.evaluations++;
+            // Midpoint sub-integrations, columns j and kc - j do the same work together
+            std::vector<std::vector<std::vector<double>>> T(kc + 1);
+            auto columns = [&, h](unsigned int j) {
+                T[j].push_back(midpoint(current, dydt, t, h, steps[j]));
+                if (kc - j != j) {
+                    T[kc - j].push_back(midpoint(current, dydt, t, h, steps[kc - j]));
+                }
+            };
+            if (pool) {
+                std::vector<std::future<void>> pending;
+                for (unsigned int j = 0; 2 * j <= kc; j++) {
+                    pending.push_back(pool->submit([&columns, j]() { columns(j); }));
+                }
+                for (std::future<void>& task: pending) {
+                    task.get();
+                }
+            } else {
+                for (unsigned int j = 0; 2 * j <= kc; j++) {
+                    columns(j);
+                }
+            }
+            for (unsigned int j = 0; j <= kc; j++) {
+                stats.evaluations += steps[j];
+            }
+            // Aitken-Neville extrapolation in h^2 and error estimates of the diagonal entries
+            std::vector<double> errors(kc + 1, 0.0);
+            std::vector<double> proposals(kc + 1, h);
+            for (unsigned int j = 1; j <= kc; j++) {
+                for (unsigned int k = 1; k <= j; k++) {
+                    double ratio = static_cast<double>(steps[j]) / steps[j - k];
+                    std::vector<double> entry(dim);
+                    for (unsigned int i = 0; i < dim; i++) {
+                        entry[i] = T[j][k - 1][i] + (T[j][k - 1][i] - T[j - 1][k - 1][i]) / (ratio * ratio - 1);
+                    }
+                    T[j].push_back(std::move(entry));
+                }
+                double sum = 0.0;
+                for (unsigned int i = 0; i < dim; i++) {
+                    double scale = tol + tol * std::max(std::abs(current[i]), std::abs(T[j][j][i]));
+                    double e = (T[j][j][i] - T[j][j - 1][i]) / scale;
+                    sum += e * e;
+                }
+                errors[j] = std::sqrt(sum / dim);
+                double factor = errors[j] == 0.0 ? 4.0 : 0.94 * std::pow(0.65 / errors[j], 1.0 / (2 * j + 1));
+                proposals[j] = h * std::clamp(factor, 0.02, 4.0);
+            }
+            if (errors[kc] > 1.0) {
+                stats.rejectedSteps++;
+                H = proposals[kc];
+                continue;
+            }
+            stats.acceptedSteps++;
+            current = std::move(T[kc][kc]);
+            t += h;
+            // Order control by the work per unit step
+            if (kc > 2 && work[kc - 1] / proposals[kc - 1] < 0.8 * work[kc] / proposals[kc]) {
+                kc--;
+                H = proposals[kc];
+            } else if (kc + 1 < maxColumns && work[kc] / proposals[kc] < 0.9 * work[kc - 1] / proposals[kc - 1]) {
+                H = proposals[kc] * work[kc + 1] / work[kc];
+                kc++;
+            } else {
+                H = proposals[kc];
+            }
+        }
+        y.push_back(current);
+        t = tGrid;
+        if (events && stopAtEvent(y, t0 + (n - 1) * stepSize, tGrid)) {
+            break;
+        }
+    }
+    return y;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "ODESystemSolver.h"
+#include "ThreadPool.h"
+
+/**
+ * @brief Class for solving systems of ODEs with the Gragg-Bulirsch-Stoer extrapolation method with adaptive order
+ * and step size.
+ *
+ * Each internal step runs the modified midpoint rule with the step numbers 2, 4, 6, ... and extrapolates the results
+ * in h^2 (Aitken-Neville). The midpoint sub-integrations of a step are independent and are run in parallel on a
+ * ThreadPool if one is given, paired so that every task does the same number of evaluations. f must then be safe to
+ * call concurrently. The solution is returned at the grid points t0 + n * stepSize, the internal steps adapt to the
+ * tolerance and are clipped at the grid points.
+ */
+class BulirschStoer : public ODESystemSolver {
+
+public:
+    /**
+     * @brief Work done by the solver.
+     *
+     * @param acceptedSteps  Number of accepted internal steps
+     * @param rejectedSteps  Number of rejected internal steps
+     * @param evaluations    Number of evaluations of f
+     */
+    struct Statistics {
+        unsigned long acceptedSteps = 0;
+        unsigned long rejectedSteps = 0;
+        unsigned long evaluations = 0;
+    };
+
+    /**
+     * @brief Construct a BulirschStoer object
+     *
+     * @param          f  Such that y' = f(y, t)
+     * @param         y0  Initial value of y
+     * @param         t0  Initial value of t
+     * @param        tol  Absolute and relative tolerance of the local error
+     * @param maxColumns  Maximum number of midpoint sub-integrations per step, at least 3
+     * @param       pool  Optional thread pool for the sub-integrations
+     */
+    BulirschStoer(SystemFunction f, std::vector<double> y0, double t0, double tol = 1e-10,
+                  unsigned int maxColumns = 10, std::shared_ptr<ThreadPool> pool = nullptr);
+
+    /**
+     * @brief Solves the system of ODEs using the extrapolation method.
+     * @param stepSize The distance of the output grid points.
+     * @param tEnd The time to solve the ODE to.
+     * @return A vector of the solution vector at each grid point.
+     */
+    std::vector<std::vector<double>> solve(double stepSize, double tEnd) override;
+
+    const Statistics& statistics() const { return stats; }
+
+private:
+    double tol;
+    unsigned int maxColumns;
+    std::shared_ptr<ThreadPool> pool;
+    Statistics stats;
+
+    /**
+     * @brief Modified midpoint rule with n substeps over H, followed by Gragg's smoothing step.
+     */
+    std::vector<double> midpoint(const std::vector<double>& y, const std::vector<double>& dydt, double t, double H,
+                                 unsigned int n) const;
+};
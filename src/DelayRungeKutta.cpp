@@ -0,0 +1,134 @@
+#include "DelayRungeKutta.h"
+#include <algorithm>
+#include <stdexcept>
+
+DelayRungeKutta::DelayRungeKutta(DelayFunction f, std::vector<double> delays, HistoryFunction history, double t0,
+                                 double tol, bool trackDiscontinuities)
+        : ODESystemSolver(nullptr, history(t0), t0), delayFunction(std::move(f)), delays(std::move(delays)),
+          history(std::move(history)), tol(tol), trackDiscontinuities(trackDiscontinuities) {
+    if (this->delays.empty()) {
+        throw std::invalid_argument("At least one delay is needed");
+    }
+    for (double tau: this->delays) {
+        if (tau <= 0.0) {
+            throw std::invalid_argument("Delays must be positive");
+        }
+    }
+}
+
+std::vector<double> DelayRungeKutta::discontinuities(double tEnd, unsigned int maxDelays) const {
+    std::vector<double> points;
+    std::vector<double> level = {t0};
+    for (unsigned int k = 0; k < maxDelays; k++) {
+        std::vector<double> next;
+        for (double point: level) {
+            for (double tau: delays) {
+                if (point + tau <= tEnd) {
+                    next.push_back(point + tau);
+                }
+            }
+        }
+        points.insert(points.end(), next.begin(), next.end());
+        level = std::move(next);
+    }
+    std::sort(points.begin(), points.end());
+    auto close = [](double a, double b) { return b - a <= 1e-12 * std::max(1.0, std::abs(b)); };
+    points.erase(std::unique(points.begin(), points.end(), close), points.end());
+    return points;
+}
+
+void DelayRungeKutta::evaluate(const std::vector<double>& y, double t, const HistoryBuffer& buffer,
+                               std::vector<unsigned long>& cursors, std::vector<std::vector<double>>& yDelayed,
+                               std::vector<double>& dydt) {
+    for (unsigned int j = 0; j < delays.size(); j++) {
+        double tDelayed = t - delays[j];
+        if (tDelayed <= t0) {
+            yDelayed[j] = history(tDelayed);
+        } else {
+            // Rounding may put t - tau a little after the newest point when the step is the delay
+            buffer.evaluate(std::min(tDelayed, buffer.newest()), yDelayed[j], cursors[j]);
+        }
+    }
+    delayFunction(y, yDelayed, t, dydt);
+    stats.evaluations++;
+}
+
+std::vector<std::vector<double>> DelayRungeKutta::solve(double stepSize, double tEnd) {
+    unsigned int N = ceil((tEnd - t0) / stepSize) + 1;
+    const unsigned int dim = y0.size();
+    stats = Statistics();
+    std::vector<std::vector<double>> y;
+    y.reserve(N);
+    y.push_back(y0);
+    const double minDelay = *std::min_element(delays.begin(), delays.end());
+    const double maxDelay = *std::max_element(delays.begin(), delays.end());
+    double H = std::min(stepSize, minDelay);
+    HistoryBuffer buffer(dim, maxDelay, static_cast<unsigned int>(ceil(maxDelay / H)) + 2);
+    std::vector<unsigned long> cursors(delays.size(), 0);
+    std::vector<std::vector<double>> yDelayed(delays.size(), std::vector<double>(dim));
+    std::vector<double> k1(dim), k2(dim), k3(dim), k4(dim), stage(dim), y1(dim);
+
+    // The jump of y' at t0 is smoothed once per delay, the local error of the third order pair sees it up to y''''
+    std::vector<double> breakpoints = trackDiscontinuities ? discontinuities(tEnd, 3) : std::vector<double>();
+    unsigned int nextBreakpoint = 0;
+
+    std::vector<double> current = y0;
+    double t = t0;
+    evaluate(current, t, buffer, cursors, yDelayed, k1);
+    buffer.push(t, current, k1);
+    for (int n = 1; n < N; n++) {
+        const double tGrid = t0 + n * stepSize;
+        while (tGrid - t > 1e-12 * std::max(1.0, std::abs(tGrid))) {
+            double tStop = tGrid;
+            while (nextBreakpoint < breakpoints.size() &&
+                   breakpoints[nextBreakpoint] - t <= 1e-12 * std::max(1.0, std::abs(t))) {
+                nextBreakpoint++;
+            }
+            if (nextBreakpoint < breakpoints.size()) {
+                tStop = std::min(tStop, breakpoints[nextBreakpoint]);
+            }
+            const double h = std::min({H, tStop - t, minDelay});
+            if (h < 1e-14 * std::max(1.0, std::abs(t))) {
+                throw std::runtime_error("DDE step size too small");
+            }
+            for (unsigned int i = 0; i < dim; i++) {
+                stage[i] = current[i] + h / 2 * k1[i];
+            }
+            evaluate(stage, t + h / 2, buffer, cursors, yDelayed, k2);
+            for (unsigned int i = 0; i < dim; i++) {
+                stage[i] = current[i] + 3 * h / 4 * k2[i];
+            }
+            evaluate(stage, t + 3 * h / 4, buffer, cursors, yDelayed, k3);
+            for (unsigned int i = 0; i < dim; i++) {
+                y1[i] = current[i] + h * (2 * k1[i] / 9 + k2[i] / 3 + 4 * k3[i] / 9);
+            }
+            const bool landsOnStop = tStop - (t + h) <= 1e-12 * std::max(1.0, std::abs(tStop));
+            const double tNew = landsOnStop ? tStop : t + h;
+            evaluate(y1, tNew, buffer, cursors, yDelayed, k4);
+            double sum = 0.0;
+            for (unsigned int i = 0; i < dim; i++) {
+                double e = h * (-5 * k1[i] / 72 + k2[i] / 12 + k3[i] / 9 - k4[i] / 8);
+                double scale = tol + tol * std::max(std::abs(current[i]), std::abs(y1[i]));
+                sum += (e / scale) * (e / scale);
+            }
+            double error = std::sqrt(sum / dim);
+            double factor = error == 0.0 ? 5.0 : std::clamp(0.9 * std::pow(error, -1.0 / 3), 0.2, 5.0);
+            if (error > 1.0) {
+                stats.rejectedSteps++;
+                H = h * factor;
+                continue;
+            }
+            // A step clipped at a grid point or discontinuity says little about the step size
+            H = h < H ? std::max(H, h * factor) : h * factor;
+            stats.acceptedSteps++;
+            t = tNew;
+            std::swap(current, y1);
+            // First same as last, k4 is f at the new point
+            std::swap(k1, k4);
+            buffer.push(t, current, k1);
+            stats.historyPoints = std::max<unsigned long>(stats.historyPoints, buffer.size());
+        }
+        y.push_back(current);
+    }
+    return y;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "ODESystemSolver.h"
+#include "HistoryBuffer.h"
+
+/**
+ * @brief Right hand side of a system of delay differential equations, writes f(y(t), y(t - tau_1), ..., t) into
+ * dydt, yDelayed[j] holds y(t - tau_j).
+ */
+using DelayFunction = std::function<void(const std::vector<double>& y, const std::vector<std::vector<double>>& yDelayed,
+                                         double t, std::vector<double>& dydt)>;
+
+/**
+ * @brief Solution for t <= t0 of a system of delay differential equations, returns y(t).
+ */
+using HistoryFunction = std::function<std::vector<double>(double t)>;
+
+/**
+ * @brief Class for solving systems of delay differential equations y'(t) = f(y(t), y(t - tau_1), ..., t) with
+ * constant delays by the Bogacki-Shampine 3(2) pair with adaptive step size (as dde23).
+ *
+ * The past is served by the history function for t <= t0 and by a HistoryBuffer of the accepted steps with cubic
+ * Hermite interpolation afterwards, which only keeps the last maximum delay. The jump of y' at t0 between the history
+ * and the solution propagates to the points t0 + tau_i, t0 + tau_i + tau_j, ..., where it gets smoother with every
+ * delay added. These discontinuities are tracked up to the order of the method and the steps are clipped at them,
+ * so that no step has to be rejected for straddling one. The steps are at most the smallest delay, so every delayed
+ * value is in the past, and they are clipped at the output grid points t0 + n * stepSize as well.
+ */
+class DelayRungeKutta : public ODESystemSolver {
+
+public:
+    /**
+     * @brief Work done by the solver.
+     *
+     * @param acceptedSteps  Number of accepted internal steps
+     * @param rejectedSteps  Number of rejected internal steps
+     * @param evaluations    Number of evaluations of f
+     * @param historyPoints  Largest number of points held by the history buffer
+     */
+    struct Statistics {
+        unsigned long acceptedSteps = 0;
+        unsigned long rejectedSteps = 0;
+        unsigned long evaluations = 0;
+        unsigned long historyPoints = 0;
+    };
+
+    /**
+     * @brief Construct a DelayRungeKutta object
+     *
+     * @param                     f  Such that y'(t) = f(y(t), y(t - delays[0]), ..., t)
+     * @param                delays  The constant, positive delays
+     * @param               history  Such that y(t) = history(t) for t <= t0
+     * @param                    t0  Initial value of t
+     * @param                   tol  Absolute and relative tolerance of the local error
+     * @param  trackDiscontinuities  Whether to step on the propagated discontinuities
+     */
+    DelayRungeKutta(DelayFunction f, std::vector<double> delays, HistoryFunction history, double t0,
+                    double tol = 1e-8, bool trackDiscontinuities = true);
+
+    /**
+     * @brief Solves the system of DDEs using the Bogacki-Shampine pair.
+     * @param stepSize The distance of the output grid points.
+     * @param tEnd The time to solve the DDE to.
+     * @return A vector of the solution vector at each grid point.
+     */
+    std::vector<std::vector<double>> solve(double stepSize, double tEnd) override;
+
+    /**
+     * @brief Not supported, y' depends on the history and there is no f(y, t) for the interpolant of a step.
+     */
+    void setEvents(std::vector<Event>) override {
+        throw std::invalid_argument("DelayRungeKutta does not support events");
+    }
+
+    const Statistics& statistics() const { return stats; }
+
+    /**
+     * @brief The points t0 + tau_i + tau_j + ... with at most maxDelays delays in (t0, tEnd], sorted.
+     */
+    std::vector<double> discontinuities(double tEnd, unsigned int maxDelays) const;
+
+private:
+    DelayFunction delayFunction;
+    std::vector<double> delays;
+    HistoryFunction history;
+    double tol;
+    bool trackDiscontinuities;
+    Statistics stats;
+
+    /**
+     * @brief Evaluates f at (y, t) with the delayed values taken from the history function or the buffer.
+     */
+    void evaluate(const std::vector<double>& y, double t, const HistoryBuffer& buffer,
+                  std::vector<unsigned long>& cursors, std::vector<std::vector<double>>& yDelayed,
+                  std::vector<double>& dydt);
+};
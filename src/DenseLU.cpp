@@ -0,0 +1,117 @@
+#include "DenseLU.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+/**
+ * @brief Computes y -= a * x for rows of length n.
+ */
+static inline void subtractScaledRow(double* __restrict y, const double* __restrict x, double a, unsigned int n) {
+    for (unsigned int j = 0; j < n; j++) {
+        y[j] -= a * x[j];
+    }
+}
+
+void DenseLU::factorize(const std::vector<double>& A, unsigned int n) {
+    if (A.size() != static_cast<std::size_t>(n) * n) {
+        throw std::invalid_argument("Matrix size does not match its dimension");
+    }
+    this->n = n;
+    lu = A;
+    pivots.resize(n);
+    double* a = lu.data();
+
+    for (unsigned int kb = 0; kb < n; kb += blockSize) {
+        unsigned int kEnd = std::min(kb + blockSize, n);
+
+        // Unblocked factorization of the panel of columns [kb, kEnd)
+        for (unsigned int k = kb; k < kEnd; k++) {
+            unsigned int p = k;
+            for (unsigned int i = k + 1; i < n; i++) {
+                if (std::abs(a[i * n + k]) > std::abs(a[p * n + k])) {
+                    p = i;
+                }
+            }
+            pivots[k] = p;
+            if (a[p * n + k] == 0.0) {
+                throw std::runtime_error("Singular matrix in dense LU factorization");
+            }
+            if (p != k) {
+                std::swap_ranges(a + k * n, a + (k + 1) * n, a + p * n);
+            }
+            double inversePivot = 1.0 / a[k * n + k];
+            for (unsigned int i = k + 1; i < n; i++) {
+                a[i * n + k] *= inversePivot;
+                subtractScaledRow(a + i * n + k + 1, a + k * n + k + 1, a[i * n + k], kEnd - k - 1);
+            }
+        }
+        if (kEnd == n) {
+            break;
+        }
+
+        // Block row of U: U12 = L11^-1 A12
+        for (unsigned int k = kb; k < kEnd; k++) {
+            for (unsigned int i = k + 1; i < kEnd; i++) {
+                subtractScaledRow(a + i * n + kEnd, a + k * n + kEnd, a[i * n + k], n - kEnd);
+            }
+        }
+
+        // Trailing update A22 -= L21 U12, one column tile of U12 at a time
+        for (unsigned int jb = kEnd; jb < n; jb += tileSize) {
+            unsigned int width = std::min(tileSize, n - jb);
+            for (unsigned int i = kEnd; i < n; i++) {
+                for (unsigned int k = kb; k < kEnd; k++) {
+                    subtractScaledRow(a + i * n + jb, a + k * n + jb, a[i * n + k], width);
+                }
+            }
+        }
+    }
+}
+
+void DenseLU::solve(std::vector<double>& b) const {
+    const double* a = lu.data();
+    for (unsigned int k = 0; k < n; k++) {
+        std::swap(b[k], b[pivots[k]]);
+    }
+    for (unsigned int i = 0; i < n; i++) {
+        double sum = b[i];
+        for (unsigned int j = 0; j < i; j++) {
+            sum -= a[i * n + j] * b[j];
+        }
+        b[i] = sum;
+    }
+    for (unsigned int i = n; i-- > 0;) {
+        double sum = b[i];
+        for (unsigned int j = i + 1; j < n; j++) {
+            sum -= a[i * n + j] * b[j];
+        }
+        b[i] = sum / a[i * n + i];
+    }
+}
+
+void DenseLU::solve(std::vector<double>& B, unsigned int count) const {
+    if (B.size() != static_cast<std::size_t>(n) * count) {
+        throw std::invalid_argument("Right hand sides do not match the dimension");
+    }
+    const double* a = lu.data();
+    double* b = B.data();
+    for (unsigned int k = 0; k < n; k++) {
+        if (pivots[k] != k) {
+            std::swap_ranges(b + k * count, b + (k + 1) * count, b + pivots[k] * count);
+        }
+    }
+    for (unsigned int i = 0; i < n; i++) {
+        for (unsigned int j = 0; j < i; j++) {
+            subtractScaledRow(b + i * count, b + j * count, a[i * n + j], count);
+        }
+    }
+    for (unsigned int i = n; i-- > 0;) {
+        for (unsigned int j = i + 1; j < n; j++) {
+            subtractScaledRow(b + i * count, b + j * count, a[i * n + j], count);
+        }
+        const double diagonal = a[i * n + i];
+        for (unsigned int j = 0; j < count; j++) {
+            b[i * count + j] /= diagonal;
+        }
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * @brief Dense LU factorization with partial pivoting, P A = L U.
+ *
+ * The factorization is right-looking and blocked: a narrow panel is factored first, then the block row of U is
+ * computed and the trailing matrix is updated tile by tile, so that the rows of U in use stay in L1/L2 cache.
+ * The matrices are stored row-major and all inner loops run over contiguous rows, which lets the compiler
+ * vectorize them.
+ */
+class DenseLU {
+
+public:
+    /**
+     * @brief Width of the factored panels.
+     */
+    static constexpr unsigned int blockSize = 32;
+
+    /**
+     * @brief Width of the column tiles of the trailing update.
+     */
+    static constexpr unsigned int tileSize = 128;
+
+    /**
+     * @brief Computes the factorization of the n x n matrix A.
+     * @param A Row-major matrix.
+     * @param n Dimension of the matrix.
+     */
+    void factorize(const std::vector<double>& A, unsigned int n);
+
+    /**
+     * @brief Solves A x = b with the current factorization.
+     * @param b Right hand side, overwritten with the solution.
+     */
+    void solve(std::vector<double>& b) const;
+
+    /**
+     * @brief Solves A X = B for count right hand sides with the current factorization.
+     *
+     * B is stored row-major (B[i * count + j] is row i of right hand side j), so that every elimination step
+     * updates a contiguous row of all right hand sides and the factors are read once for the whole batch.
+     * @param B     Right hand sides, overwritten with the solutions.
+     * @param count Number of right hand sides.
+     */
+    void solve(std::vector<double>& B, unsigned int count) const;
+
+    /**
+     * @brief Dimension of the factorized matrix.
+     */
+    unsigned int size() const { return n; }
+
+private:
+    unsigned int n = 0;
+    std::vector<double> lu;
+    std::vector<unsigned int> pivots;
+};
@@ -0,0 +1,31 @@
+#include "DenseLinearSolver.h"
+
+void DenseLinearSolver::setup(const std::vector<double>& y, double t, double gamma) {
+    unsigned int n = y.size();
+    matrix.assign(static_cast<std::size_t>(n) * n, 0.0);
+    jacobian(y, t, matrix);
+    for (double& entry: matrix) {
+        entry *= -gamma;
+    }
+    if (mass) {
+        mass(y, t, M);
+        for (unsigned int i = 0; i < n; i++) {
+            for (unsigned int p = M.rowPtr[i]; p < M.rowPtr[i + 1]; p++) {
+                matrix[i * n + M.colIdx[p]] += M.values[p];
+            }
+        }
+    } else {
+        for (unsigned int i = 0; i < n; i++) {
+            matrix[i * n + i] += 1.0;
+        }
+    }
+    lu.factorize(matrix, n);
+}
+
+void DenseLinearSolver::solve(std::vector<double>& b) {
+    lu.solve(b);
+}
+
+void DenseLinearSolver::solve(std::vector<double>& B, unsigned int count) {
+    lu.solve(B, count);
+}
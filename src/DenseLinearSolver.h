@@ -0,0 +1,42 @@
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include "LinearSolver.h"
+#include "DenseLU.h"
+
+/**
+ * @brief Jacobian of a system of ODEs, writes df(y, t)/dy row-major into J.
+ */
+using DenseJacobianFunction = std::function<void(const std::vector<double>& y, double t, std::vector<double>& J)>;
+
+/**
+ * @brief Solves the Newton systems with a dense Jacobian and the blocked DenseLU kernel.
+ *
+ */
+class DenseLinearSolver : public LinearSolver {
+
+public:
+    /**
+     * @brief Construct a DenseLinearSolver object
+     *
+     * @param jacobian Such that jacobian(y, t) = df(y, t)/dy
+     */
+    explicit DenseLinearSolver(DenseJacobianFunction jacobian) : jacobian(std::move(jacobian)) {}
+
+    void setup(const std::vector<double>& y, double t, double gamma) override;
+
+    void solve(std::vector<double>& b) override;
+
+    void solve(std::vector<double>& B, unsigned int count) override;
+
+    void setMassMatrix(MassMatrixFunction mass) override { this->mass = std::move(mass); }
+
+private:
+    MassMatrixFunction mass;
+    CSRMatrix M;
+    DenseJacobianFunction jacobian;
+    std::vector<double> matrix;
+    DenseLU lu;
+};
@@ -0,0 +1,122 @@
+#include "DenseOutput.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+DenseOutput::DenseOutput(double t0, double stepSize, std::vector<std::vector<double>> y,
+                         std::vector<std::vector<double>> dydt, Order order)
+        : t0(t0), stepSize(stepSize), y(std::move(y)), dydt(std::move(dydt)), order(order) {
+    if (this->y.empty() || this->y.size() != this->dydt.size()) {
+        throw std::invalid_argument("Dense output needs a derivative for every value");
+    }
+}
+
+DenseOutput DenseOutput::fromFunction(
+        const std::function<void(const std::vector<double>& y, double t, std::vector<double>& dydt)>& f,
+        double t0, double stepSize, std::vector<std::vector<double>> y, Order order) {
+    std::vector<std::vector<double>> dydt(y.size());
+    for (unsigned int n = 0; n < y.size(); n++) {
+        dydt[n].resize(y[n].size());
+        f(y[n], t0 + n * stepSize, dydt[n]);
+    }
+    return {t0, stepSize, std::move(y), std::move(dydt), order};
+}
+
+DenseOutput DenseOutput::fromValues(double t0, double stepSize, std::vector<std::vector<double>> y, Order order) {
+    const unsigned int N = y.size();
+    if (N == 0) {
+        throw std::invalid_argument("Dense output needs a derivative for every value");
+    }
+    const unsigned int dim = y[0].size();
+    std::vector<std::vector<double>> dydt(N, std::vector<double>(dim, 0.0));
+    // Five point stencils, one-sided near the ends, fewer points for short solutions
+    auto stencil = [&](unsigned int n, unsigned int first, const std::vector<double>& weights, double scale) {
+        for (unsigned int i = 0; i < dim; i++) {
+            double sum = 0.0;
+            for (unsigned int k = 0; k < weights.size(); k++) {
+                sum += weights[k] * y[first + k][i];
+            }
+            dydt[n][i] = sum / (scale * stepSize);
+        }
+    };
+    for (unsigned int n = 0; n < N && N > 1; n++) {
+        if (N == 2) {
+            stencil(n, 0, {-1, 1}, 1);
+        } else if (N < 5) {
+            if (n == 0) {
+                stencil(n, 0, {-3, 4, -1}, 2);
+            } else if (n == N - 1) {
+                stencil(n, N - 3, {1, -4, 3}, 2);
+            } else {
+                stencil(n, n - 1, {-1, 0, 1}, 2);
+            }
+        } else if (n == 0) {
+            stencil(n, 0, {-25, 48, -36, 16, -3}, 12);
+        } else if (n == 1) {
+            stencil(n, 0, {-3, -10, 18, -6, 1}, 12);
+        } else if (n == N - 2) {
+            stencil(n, N - 5, {-1, 6, -18, 10, 3}, 12);
+        } else if (n == N - 1) {
+            stencil(n, N - 5, {3, -16, 36, -48, 25}, 12);
+        } else {
+            stencil(n, n - 2, {1, -8, 0, 8, -1}, 12);
+        }
+    }
+    return {t0, stepSize, std::move(y), std::move(dydt), order};
+}
+
+void DenseOutput::evaluate(double t, std::vector<double>& result) const {
+    const double tol = 1e-12 * std::max(1.0, std::abs(end()));
+    if (t < t0 - tol || t > end() + tol) {
+        throw std::out_of_range("Time is outside of the dense output");
+    }
+    const unsigned int dim = y[0].size();
+    result.resize(dim);
+    if (y.size() == 1) {
+        result = y[0];
+        return;
+    }
+    // Step [a, a + 1] containing t, in units of the step size
+    const double x = (t - t0) / stepSize;
+    const unsigned int a = std::min<unsigned int>(std::max(0.0, std::floor(x)), y.size() - 2);
+    const double s = x - a;
+    unsigned int first = a;
+    unsigned int points = 2;
+    if (order == Order::Quintic && y.size() >= 3) {
+        points = 3;
+        first = (s < 0.5 && a > 0) || a + 2 >= y.size() ? a - 1 : a;
+    }
+    // Newton form of the Hermite polynomial on the doubled nodes, in the variable (t - t0) / stepSize - first
+    double z[6];
+    double q[6];
+    for (unsigned int k = 0; k < 2 * points; k++) {
+        z[k] = k / 2;
+    }
+    const double u = x - first;
+    for (unsigned int i = 0; i < dim; i++) {
+        for (unsigned int k = 0; k < 2 * points; k++) {
+            q[k] = y[first + k / 2][i];
+        }
+        // Divided differences in place, a repeated node gives the scaled derivative
+        for (unsigned int level = 1; level < 2 * points; level++) {
+            for (unsigned int k = 2 * points - 1; k >= level; k--) {
+                if (z[k] == z[k - level]) {
+                    q[k] = stepSize * dydt[first + k / 2][i];
+                } else {
+                    q[k] = (q[k] - q[k - 1]) / (z[k] - z[k - level]);
+                }
+            }
+        }
+        double value = q[2 * points - 1];
+        for (unsigned int k = 2 * points - 1; k-- > 0;) {
+            value = value * (u - z[k]) + q[k];
+        }
+        result[i] = value;
+    }
+}
+
+std::vector<double> DenseOutput::operator()(double t) const {
+    std::vector<double> result;
+    evaluate(t, result);
+    return result;
+}
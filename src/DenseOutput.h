@@ -0,0 +1,83 @@
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Continuous solution of a finished solve, evaluated at any t between the first and the last step.
+ *
+ * The solution is stored at the steps t0 + n * stepSize together with y' there, and interpolated by Hermite
+ * polynomials through the values and derivatives of neighbouring steps: cubic through the two ends of the step
+ * containing t (local error O(h^4)), or quintic through three steps (local error O(h^6)), which keeps the accuracy
+ * of higher order methods such as RungeKutta or BulirschStoer between the steps. The derivatives are f(y, t) at the
+ * steps, or, for solvers without a right hand side of the form y' = f(y, t), fourth order differences of the values.
+ * The solve can then use coarse steps and the solution is sampled as densely as needed afterwards.
+ */
+class DenseOutput {
+
+public:
+    enum class Order {
+        Cubic,   // Hermite interpolation on the step, two points
+        Quintic  // Hermite interpolation on the step and the neighbouring step closer to t, three points
+    };
+
+    /**
+     * @brief Construct a DenseOutput object from values and derivatives
+     *
+     * @param       t0  Time of the first value
+     * @param stepSize  The step size
+     * @param        y  The solution at each step
+     * @param     dydt  The derivative at each step
+     * @param    order  The interpolation
+     */
+    DenseOutput(double t0, double stepSize, std::vector<std::vector<double>> y,
+                std::vector<std::vector<double>> dydt, Order order = Order::Cubic);
+
+    /**
+     * @brief Dense output with the derivatives f(y, t) at the steps.
+     */
+    static DenseOutput fromFunction(
+            const std::function<void(const std::vector<double>& y, double t, std::vector<double>& dydt)>& f,
+            double t0, double stepSize, std::vector<std::vector<double>> y, Order order = Order::Cubic);
+
+    /**
+     * @brief Dense output with the derivatives approximated by fourth order differences of the values.
+     */
+    static DenseOutput fromValues(double t0, double stepSize, std::vector<std::vector<double>> y,
+                                  Order order = Order::Cubic);
+
+    /**
+     * @brief Interpolates the solution at time t.
+     * @param t Time between the first and the last step
+     * @param y Output, resized to the dimension
+     */
+    void evaluate(double t, std::vector<double>& y) const;
+
+    /**
+     * @brief Interpolates the solution at time t.
+     */
+    std::vector<double> operator()(double t) const;
+
+    /**
+     * @brief Time of the first step.
+     */
+    double begin() const { return t0; }
+
+    /**
+     * @brief Time of the last step.
+     */
+    double end() const { return t0 + (y.size() - 1) * stepSize; }
+
+    /**
+     * @brief The solution at the steps.
+     */
+    const std::vector<std::vector<double>>& values() const { return y; }
+
+private:
+    double t0;
+    double stepSize;
+    std::vector<std::vector<double>> y;
+    std::vector<std::vector<double>> dydt;
+    Order order;
+};
@@ -0,0 +1,156 @@
+#include "ETDRK4.h"
+#include <stdexcept>
+#include "MatrixFunctions.h"
+
+/**
+ * @brief The full right hand side L y + N(y, t).
+ */
+static SystemFunction semilinear(std::vector<double> L, SystemFunction N, bool isDiagonal) {
+    return [L = std::move(L), N = std::move(N), isDiagonal](const std::vector<double>& y, double t,
+                                                            std::vector<double>& dydt) {
+        N(y, t, dydt);
+        const unsigned int n = y.size();
+        for (unsigned int i = 0; i < n; i++) {
+            if (isDiagonal) {
+                dydt[i] += L[i] * y[i];
+                continue;
+            }
+            for (unsigned int j = 0; j < n; j++) {
+                dydt[i] += L[i * n + j] * y[j];
+            }
+        }
+    };
+}
+
+ETDRK4::ETDRK4(std::vector<double> L, SystemFunction N, std::vector<double> y0, double t0, bool isDiagonal)
+        : ODESystemSolver(semilinear(L, N, isDiagonal), std::move(y0), t0), L(std::move(L)), nonlinear(std::move(N)),
+          isDiagonal(isDiagonal) {
+    std::size_t n = this->y0.size();
+    if (this->L.size() != (isDiagonal ? n : n * n)) {
+        throw std::invalid_argument("Size of the linear part does not match y0");
+    }
+}
+
+ETDRK4::ETDRK4(std::vector<double> L, SystemFunction N, std::vector<double> y0, double t0)
+        : ETDRK4(std::move(L), std::move(N), std::move(y0), t0, false) {}
+
+ETDRK4 ETDRK4::diagonal(std::vector<double> L, SystemFunction N, std::vector<double> y0, double t0) {
+    return {std::move(L), std::move(N), std::move(y0), t0, true};
+}
+
+const ETDRK4::Coefficients& ETDRK4::coefficients(double stepSize) {
+    auto cached = cache.find(stepSize);
+    if (cached != cache.end()) {
+        return cached->second;
+    }
+    const double h = stepSize;
+    const unsigned int n = y0.size();
+    Coefficients c;
+    auto combine = [h](const std::vector<double>& phi1, const std::vector<double>& phi2,
+                       const std::vector<double>& phi3, double a1, double a2, double a3) {
+        std::vector<double> result(phi2.size());
+        for (unsigned int i = 0; i < result.size(); i++) {
+            result[i] = h * (a1 * phi1[i] + a2 * phi2[i] + a3 * phi3[i]);
+        }
+        return result;
+    };
+    auto scaled = [](std::vector<double> M, double factor) {
+        for (double& entry: M) {
+            entry *= factor;
+        }
+        return M;
+    };
+    if (isDiagonal) {
+        std::vector<double> phi0(n), phi1(n), phi2(n), phi3(n), halfPhi0(n), halfPhi1(n);
+        for (unsigned int i = 0; i < n; i++) {
+            std::vector<double> full = matrixFunctions::phi(h * L[i], 3);
+            std::vector<double> half = matrixFunctions::phi(h * L[i] / 2, 1);
+            phi0[i] = full[0];
+            phi1[i] = full[1];
+            phi2[i] = full[2];
+            phi3[i] = full[3];
+            halfPhi0[i] = half[0];
+            halfPhi1[i] = half[1];
+        }
+        c.E = phi0;
+        c.E2 = halfPhi0;
+        c.Q = scaled(halfPhi1, h / 2);
+        c.F1 = combine(phi1, phi2, phi3, 1.0, -3.0, 4.0);
+        c.F2 = combine(phi1, phi2, phi3, 0.0, 2.0, -4.0);
+        c.F3 = combine(phi1, phi2, phi3, 0.0, -1.0, 4.0);
+    } else {
+        std::vector<double> Z(L.size());
+        for (unsigned int i = 0; i < L.size(); i++) {
+            Z[i] = h * L[i];
+        }
+        std::vector<std::vector<double>> full = matrixFunctions::phi(Z, n, 3);
+        for (double& z: Z) {
+            z /= 2;
+        }
+        std::vector<std::vector<double>> half = matrixFunctions::phi(Z, n, 1);
+        c.E = full[0];
+        c.E2 = half[0];
+        c.Q = scaled(half[1], h / 2);
+        c.F1 = combine(full[1], full[2], full[3], 1.0, -3.0, 4.0);
+        c.F2 = combine(full[1], full[2], full[3], 0.0, 2.0, -4.0);
+        c.F3 = combine(full[1], full[2], full[3], 0.0, -1.0, 4.0);
+    }
+    return cache.emplace(stepSize, std::move(c)).first->second;
+}
+
+void ETDRK4::apply(const std::vector<double>& M, const std::vector<double>& x, std::vector<double>& out,
+                   bool accumulate) const {
+    const unsigned int n = x.size();
+    for (unsigned int i = 0; i < n; i++) {
+        double sum = 0.0;
+        if (isDiagonal) {
+            sum = M[i] * x[i];
+        } else {
+            for (unsigned int j = 0; j < n; j++) {
+                sum += M[i * n + j] * x[j];
+            }
+        }
+        out[i] = accumulate ? out[i] + sum : sum;
+    }
+}
+
+std::vector<std::vector<double>> ETDRK4::solve(double stepSize, double tEnd) {
+    double t = t0;
+    unsigned int N = ceil((tEnd - t0) / stepSize) + 1;
+    const unsigned int n = y0.size();
+    const Coefficients& c = coefficients(stepSize);
+    std::vector<std::vector<double>> y;
+    y.reserve(N);
+    y.push_back(y0);
+    std::vector<double> Nu(n), Na(n), Nb(n), Nc(n), a_n(n), b_n(n), stage(n), c_n(n);
+    for (int k = 1; k < N; k++) {
+        const std::vector<double>& u = y.back();
+        std::vector<double> y_new(n);
+        nonlinear(u, t, Nu);
+        apply(c.E2, u, a_n, false);
+        apply(c.Q, Nu, a_n, true);
+        nonlinear(a_n, t + stepSize / 2, Na);
+        apply(c.E2, u, b_n, false);
+        apply(c.Q, Na, b_n, true);
+        nonlinear(b_n, t + stepSize / 2, Nb);
+        for (unsigned int i = 0; i < n; i++) {
+            stage[i] = 2 * Nb[i] - Nu[i];
+        }
+        apply(c.E2, a_n, c_n, false);
+        apply(c.Q, stage, c_n, true);
+        nonlinear(c_n, t + stepSize, Nc);
+        for (unsigned int i = 0; i < n; i++) {
+            stage[i] = Na[i] + Nb[i];
+        }
+        apply(c.E, u, y_new, false);
+        apply(c.F1, Nu, y_new, true);
+        apply(c.F2, stage, y_new, true);
+        apply(c.F3, Nc, y_new, true);
+        y.push_back(std::move(y_new));
+        if (events && stopAtEvent(y, t0 + (k - 1) * stepSize, t0 + k * stepSize)) {
+            break;
+        }
+        t = t0 + k * stepSize;
+    }
+    return y;
+}
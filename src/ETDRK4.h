@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+#include "ODESystemSolver.h"
+
+/**
+ * @brief Class for solving semilinear systems y' = L y + N(y, t) with the exponential time differencing
+ * Runge-Kutta method of order 4 (ETDRK4 of Cox and Matthews).
+ *
+ * The stiff linear part is integrated exactly through the matrix functions e^{hL} and phi_k(hL), so the step size
+ * is only limited by the nonlinear part N. The matrix functions depend only on the step size and are computed once
+ * per step size and cached. L is either a dense row-major matrix or a diagonal, e.g. after a Fourier transform.
+ */
+class ETDRK4 : public ODESystemSolver {
+
+public:
+    /**
+     * @brief Construct an ETDRK4 object with a dense linear part
+     *
+     * @param  L  Row-major n x n matrix of the linear part
+     * @param  N  Such that y' = L y + N(y, t)
+     * @param y0  Initial value of y
+     * @param t0  Initial value of t
+     */
+    ETDRK4(std::vector<double> L, SystemFunction N, std::vector<double> y0, double t0);
+
+    /**
+     * @brief Construct an ETDRK4 object with a diagonal linear part
+     *
+     * @param  L  Diagonal of the linear part
+     * @param  N  Such that y' = diag(L) y + N(y, t)
+     * @param y0  Initial value of y
+     * @param t0  Initial value of t
+     */
+    static ETDRK4 diagonal(std::vector<double> L, SystemFunction N, std::vector<double> y0, double t0);
+
+    /**
+     * @brief Solves the system of ODEs using the ETDRK4 method.
+     * @param stepSize The step size.
+     * @param tEnd The time to solve the ODE to.
+     * @return A vector of the solution vector at each step.
+     */
+    std::vector<std::vector<double>> solve(double stepSize, double tEnd) override;
+
+private:
+    /**
+     * @brief Matrix functions of one step size, either n x n matrices or diagonals.
+     *
+     * @param E      e^{hL}
+     * @param E2     e^{hL/2}
+     * @param Q      h/2 phi_1(hL/2)
+     * @param F1     h (phi_1 - 3 phi_2 + 4 phi_3)(hL)
+     * @param F2     h (2 phi_2 - 4 phi_3)(hL)
+     * @param F3     h (4 phi_3 - phi_2)(hL)
+     */
+    struct Coefficients {
+        std::vector<double> E, E2, Q, F1, F2, F3;
+    };
+
+    std::vector<double> L;
+    SystemFunction nonlinear;
+    bool isDiagonal;
+    std::map<double, Coefficients> cache;
+
+    ETDRK4(std::vector<double> L, SystemFunction N, std::vector<double> y0, double t0, bool isDiagonal);
+
+    const Coefficients& coefficients(double stepSize);
+
+    /**
+     * @brief Computes out = M x for a coefficient M, accumulating if accumulate is set.
+     */
+    void apply(const std::vector<double>& M, const std::vector<double>& x, std::vector<double>& out,
+               bool accumulate) const;
+};
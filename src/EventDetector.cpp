@@ -0,0 +1,147 @@
+#include "EventDetector.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+EventDetector::EventDetector(std::vector<Event> events, double tol) : events(std::move(events)), tol(tol) {
+    for (const Event& event: this->events) {
+        if (!event.g) {
+            throw std::invalid_argument("Event without event function");
+        }
+    }
+}
+
+void EventDetector::start(const std::vector<double>& y, double t) {
+    log.clear();
+    values.resize(events.size());
+    for (unsigned int k = 0; k < events.size(); k++) {
+        values[k] = events[k].g(y, t);
+    }
+}
+
+double EventDetector::brent(const std::function<double(double)>& phi, double a, double b, double fa, double fb,
+                            double tol) {
+    const double eps = std::numeric_limits<double>::epsilon();
+    double c = b;
+    double fc = fb;
+    double d = b - a;
+    double e = d;
+    for (unsigned int iteration = 0; iteration < 100; iteration++) {
+        if ((fb > 0) == (fc > 0)) {
+            c = a;
+            fc = fa;
+            d = b - a;
+            e = d;
+        }
+        if (std::abs(fc) < std::abs(fb)) {
+            a = b;
+            b = c;
+            c = a;
+            fa = fb;
+            fb = fc;
+            fc = fa;
+        }
+        const double bound = 2 * eps * std::abs(b) + tol / 2;
+        const double m = (c - b) / 2;
+        if (std::abs(m) <= bound || fb == 0.0) {
+            return b;
+        }
+        if (std::abs(e) >= bound && std::abs(fa) > std::abs(fb)) {
+            // Secant or inverse quadratic interpolation
+            double s = fb / fa;
+            double p, q;
+            if (a == c) {
+                p = 2 * m * s;
+                q = 1 - s;
+            } else {
+                double r = fb / fc;
+                q = fa / fc;
+                p = s * (2 * m * q * (q - r) - (b - a) * (r - 1));
+                q = (q - 1) * (r - 1) * (s - 1);
+            }
+            if (p > 0) {
+                q = -q;
+            } else {
+                p = -p;
+            }
+            if (2 * p < std::min(3 * m * q - std::abs(bound * q), std::abs(e * q))) {
+                e = d;
+                d = p / q;
+            } else {
+                d = m;
+                e = d;
+            }
+        } else {
+            d = m;
+            e = d;
+        }
+        a = b;
+        fa = fb;
+        b += std::abs(d) > bound ? d : (m > 0 ? bound : -bound);
+        fb = phi(b);
+    }
+    return b;
+}
+
+bool EventDetector::step(const std::function<void(const std::vector<double>& y, double t,
+                                                  std::vector<double>& dydt)>& f,
+                         const std::vector<double>& y0, double t0, const std::vector<double>& y1, double t1) {
+    next.resize(events.size());
+    std::vector<unsigned int> crossed;
+    for (unsigned int k = 0; k < events.size(); k++) {
+        next[k] = events[k].g(y1, t1);
+        // A zero at the start of the step was recorded with the previous step
+        if (values[k] == 0.0 || (next[k] != 0.0 && (values[k] > 0) == (next[k] > 0))) {
+            continue;
+        }
+        const bool rising = values[k] < 0;
+        if ((events[k].direction == Event::Direction::Rising && !rising) ||
+            (events[k].direction == Event::Direction::Falling && rising)) {
+            continue;
+        }
+        crossed.push_back(k);
+    }
+    if (crossed.empty()) {
+        values.swap(next);
+        return false;
+    }
+    // Cubic Hermite interpolant of the step
+    const unsigned int n = y0.size();
+    const double h = t1 - t0;
+    std::vector<double> dy0(n), dy1(n), y(n);
+    f(y0, t0, dy0);
+    f(y1, t1, dy1);
+    auto interpolate = [&](double t) {
+        const double s = (t - t0) / h;
+        const double h00 = (1 + 2 * s) * (1 - s) * (1 - s);
+        const double h10 = s * (1 - s) * (1 - s);
+        const double h01 = s * s * (3 - 2 * s);
+        const double h11 = s * s * (s - 1);
+        for (unsigned int i = 0; i < n; i++) {
+            y[i] = h00 * y0[i] + h10 * h * dy0[i] + h01 * y1[i] + h11 * h * dy1[i];
+        }
+        return y;
+    };
+    std::vector<EventRecord> found;
+    for (unsigned int k: crossed) {
+        if (next[k] == 0.0) {
+            found.push_back({k, t1, y1});
+            continue;
+        }
+        auto phi = [&](double t) { return events[k].g(interpolate(t), t); };
+        double t = brent(phi, t0, t1, values[k], next[k], tol);
+        found.push_back({k, t, interpolate(t)});
+    }
+    std::stable_sort(found.begin(), found.end(),
+                     [](const EventRecord& a, const EventRecord& b) { return a.t < b.t; });
+    values.swap(next);
+    for (EventRecord& record: found) {
+        const bool terminal = events[record.event].terminal;
+        log.push_back(std::move(record));
+        if (terminal) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Event function, an event occurs where g(y, t) crosses zero.
+ */
+using EventFunction = std::function<double(const std::vector<double>& y, double t)>;
+
+/**
+ * @brief An event function with its options.
+ *
+ * @param         g  The event function
+ * @param  terminal  Whether the integration stops at the event
+ * @param direction  Crossings to detect, Rising for g going from negative to positive, Falling for the reverse
+ */
+struct Event {
+    enum class Direction {
+        Both,
+        Rising,
+        Falling
+    };
+
+    EventFunction g;
+    bool terminal = false;
+    Direction direction = Direction::Both;
+};
+
+/**
+ * @brief A located event.
+ *
+ * @param event  Index of the event function
+ * @param     t  Time of the zero crossing
+ * @param     y  Solution at t
+ */
+struct EventRecord {
+    unsigned int event;
+    double t;
+    std::vector<double> y;
+};
+
+/**
+ * @brief Detects and locates the zero crossings of event functions along the steps of a solver.
+ *
+ * After every step the event functions are evaluated at the new value and compared in sign with the previous one,
+ * which costs one evaluation of each g per step. Only in a step with a sign change f is evaluated at both ends, and
+ * the crossing is located by Brent's method on g along the cubic Hermite interpolant of the step. The crossings of a
+ * step are recorded in time order, up to and including the first terminal one.
+ */
+class EventDetector {
+
+public:
+    /**
+     * @brief Construct an EventDetector object
+     *
+     * @param events  The event functions
+     * @param    tol  Absolute tolerance of the event times
+     */
+    explicit EventDetector(std::vector<Event> events, double tol = 1e-12);
+
+    /**
+     * @brief Clears the records and evaluates the event functions at the initial value.
+     */
+    void start(const std::vector<double>& y, double t);
+
+    /**
+     * @brief Checks the step from (y0, t0) to (y1, t1) for events.
+     * @param f  Right hand side, evaluated for the interpolant only if an event function changes sign
+     * @return Whether a terminal event occurred in the step.
+     */
+    bool step(const std::function<void(const std::vector<double>& y, double t, std::vector<double>& dydt)>& f,
+              const std::vector<double>& y0, double t0, const std::vector<double>& y1, double t1);
+
+    /**
+     * @brief The events located since the last start, in time order.
+     */
+    const std::vector<EventRecord>& records() const { return log; }
+
+    /**
+     * @brief Brent's method for a zero of phi in [a, b], given phi(a) = fa and phi(b) = fb of opposite signs.
+     */
+    static double brent(const std::function<double(double)>& phi, double a, double b, double fa, double fb,
+                        double tol);
+
+private:
+    std::vector<Event> events;
+    double tol;
+    std::vector<double> values;
+    std::vector<double> next;
+    std::vector<EventRecord> log;
+};
@@ -9,6 +9,9 @@ std::vector<double> ExplicitEuler::solve(double stepSize, double tEnd) {
     for (int n = 1; n < N; n++) {
         t = t0 + n * stepSize;
         y.emplace_back(y.back() + stepSize * f(y.back(), t));
+        if (events && stopAtEvent(y, t0 + (n - 1) * stepSize, t0 + n * stepSize)) {
+            break;
+        }
     }
     return y;
 }
\ No newline at end of file
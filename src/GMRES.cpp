@@ -0,0 +1,121 @@
+#include "GMRES.h"
+#include <cmath>
+
+static double dot(const std::vector<double>& a, const std::vector<double>& b) {
+    double sum = 0.0;
+    for (unsigned int i = 0; i < a.size(); i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+bool GMRES::solve(const Operator& A, const std::vector<double>& b, std::vector<double>& x,
+                  const Preconditioner& preconditioner) {
+    const unsigned int n = b.size();
+    const unsigned int m = restart;
+    basis.resize(m + 1);
+    for (auto& v: basis) {
+        v.resize(n);
+    }
+    hessenberg.resize((m + 1) * m);
+    rotationCos.resize(m);
+    rotationSin.resize(m);
+    g.resize(m + 1);
+    r.resize(n);
+    w.resize(n);
+    x.resize(n, 0.0);
+    lastIterations = 0;
+
+    auto H = [this, m](unsigned int i, unsigned int j) -> double& { return hessenberg[i * m + j]; };
+    auto residual = [&]() {
+        A(x, r);
+        for (unsigned int i = 0; i < n; i++) {
+            r[i] = b[i] - r[i];
+        }
+        return std::sqrt(dot(r, r));
+    };
+
+    double target = tol * std::sqrt(dot(b, b));
+    double beta = residual();
+    bool breakdown = false;
+    while (beta > target && lastIterations < maxIter && !breakdown) {
+        for (unsigned int i = 0; i < n; i++) {
+            basis[0][i] = r[i] / beta;
+        }
+        std::fill(g.begin(), g.end(), 0.0);
+        g[0] = beta;
+
+        unsigned int k = 0;
+        while (k < m && lastIterations < maxIter) {
+            w = basis[k];
+            if (preconditioner) {
+                preconditioner(w);
+            }
+            std::vector<double>& v = basis[k + 1];
+            A(w, v);
+            // Modified Gram-Schmidt
+            for (unsigned int i = 0; i <= k; i++) {
+                H(i, k) = dot(v, basis[i]);
+                for (unsigned int l = 0; l < n; l++) {
+                    v[l] -= H(i, k) * basis[i][l];
+                }
+            }
+            H(k + 1, k) = std::sqrt(dot(v, v));
+            if (H(k + 1, k) > 0.0) {
+                for (unsigned int l = 0; l < n; l++) {
+                    v[l] /= H(k + 1, k);
+                }
+            }
+            // Givens rotations reduce the Hessenberg matrix to triangular form
+            for (unsigned int i = 0; i < k; i++) {
+                double temp = rotationCos[i] * H(i, k) + rotationSin[i] * H(i + 1, k);
+                H(i + 1, k) = -rotationSin[i] * H(i, k) + rotationCos[i] * H(i + 1, k);
+                H(i, k) = temp;
+            }
+            double denominator = std::hypot(H(k, k), H(k + 1, k));
+            if (denominator == 0.0) {
+                // A maps the new basis vector into the previous ones, the Krylov space cannot grow: keep the
+                // solution of the first k columns and stop
+                rotationCos[k] = 1.0;
+                rotationSin[k] = 0.0;
+                breakdown = true;
+                break;
+            }
+            rotationCos[k] = H(k, k) / denominator;
+            rotationSin[k] = H(k + 1, k) / denominator;
+            H(k, k) = denominator;
+            H(k + 1, k) = 0.0;
+            g[k + 1] = -rotationSin[k] * g[k];
+            g[k] = rotationCos[k] * g[k];
+
+            k++;
+            lastIterations++;
+            if (std::abs(g[k]) <= target) {
+                break;
+            }
+        }
+
+        // Back substitution for the Krylov coefficients, then x += M^-1 V y
+        for (unsigned int i = k; i-- > 0;) {
+            double sum = g[i];
+            for (unsigned int j = i + 1; j < k; j++) {
+                sum -= H(i, j) * g[j];
+            }
+            g[i] = sum / H(i, i);
+        }
+        std::fill(w.begin(), w.end(), 0.0);
+        for (unsigned int j = 0; j < k; j++) {
+            for (unsigned int l = 0; l < n; l++) {
+                w[l] += g[j] * basis[j][l];
+            }
+        }
+        if (preconditioner) {
+            preconditioner(w);
+        }
+        for (unsigned int l = 0; l < n; l++) {
+            x[l] += w[l];
+        }
+        beta = residual();
+    }
+    return beta <= target;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Restarted GMRES(m) for general linear systems given only through matrix-vector products.
+ *
+ * Preconditioning is applied from the right, so the monitored residual is the residual of the original system.
+ * Besides a few work vectors only the m + 1 Krylov basis vectors are stored, i.e. the memory is O(m n).
+ */
+class GMRES {
+
+public:
+    /**
+     * @brief Computes Av = A * v.
+     */
+    using Operator = std::function<void(const std::vector<double>& v, std::vector<double>& Av)>;
+
+    /**
+     * @brief Overwrites v with M^-1 * v for a preconditioner M.
+     */
+    using Preconditioner = std::function<void(std::vector<double>& v)>;
+
+    /**
+     * @brief Construct a GMRES object
+     *
+     * @param restart  Dimension m of the Krylov space before restarting
+     * @param tol      Required reduction of the residual norm relative to the norm of b
+     * @param maxIter  Maximum number of iterations over all restarts
+     */
+    explicit GMRES(unsigned int restart = 30, double tol = 1e-6, unsigned int maxIter = 500)
+            : restart(restart), tol(tol), maxIter(maxIter) {}
+
+    /**
+     * @brief Solves A x = b.
+     * @param A               The matrix as an operator
+     * @param b               Right hand side
+     * @param x               Initial guess, overwritten with the solution
+     * @param preconditioner  Optional right preconditioner
+     * @return Whether the required residual reduction was reached, false also after a breakdown of the Arnoldi
+     * process, e.g. for a singular A.
+     */
+    bool solve(const Operator& A, const std::vector<double>& b, std::vector<double>& x,
+               const Preconditioner& preconditioner = nullptr);
+
+    /**
+     * @brief Number of iterations of the last solve.
+     */
+    unsigned int iterations() const { return lastIterations; }
+
+private:
+    unsigned int restart;
+    double tol;
+    unsigned int maxIter;
+    unsigned int lastIterations = 0;
+    std::vector<std::vector<double>> basis;
+    std::vector<double> hessenberg;
+    std::vector<double> rotationCos;
+    std::vector<double> rotationSin;
+    std::vector<double> g;
+    std::vector<double> r;
+    std::vector<double> w;
+};
@@ -0,0 +1,78 @@
+#include "HistoryBuffer.h"
+#include <algorithm>
+#include <stdexcept>
+
+HistoryBuffer::HistoryBuffer(unsigned int dimension, double span, unsigned int capacity)
+        : dimension(dimension), span(span), capacity(std::max(capacity, 2u)), times(this->capacity),
+          values(static_cast<std::size_t>(this->capacity) * dimension),
+          derivatives(static_cast<std::size_t>(this->capacity) * dimension) {
+    if (span < 0.0) {
+        throw std::invalid_argument("History span must not be negative");
+    }
+}
+
+void HistoryBuffer::grow() {
+    unsigned int newCapacity = 2 * capacity;
+    std::vector<double> newTimes(newCapacity);
+    std::vector<double> newValues(static_cast<std::size_t>(newCapacity) * dimension);
+    std::vector<double> newDerivatives(static_cast<std::size_t>(newCapacity) * dimension);
+    for (unsigned long a = first; a < last; a++) {
+        unsigned int from = a % capacity;
+        unsigned int to = a % newCapacity;
+        newTimes[to] = times[from];
+        std::copy_n(values.begin() + from * dimension, dimension, newValues.begin() + to * dimension);
+        std::copy_n(derivatives.begin() + from * dimension, dimension, newDerivatives.begin() + to * dimension);
+    }
+    capacity = newCapacity;
+    times = std::move(newTimes);
+    values = std::move(newValues);
+    derivatives = std::move(newDerivatives);
+}
+
+void HistoryBuffer::push(double t, const std::vector<double>& y, const std::vector<double>& dydt) {
+    if (last > first && t <= newest()) {
+        throw std::invalid_argument("History points have to be pushed in increasing time");
+    }
+    // Keep the newest point at or before t - span, it is needed to interpolate up to t - span
+    while (last - first >= 2 && times[(first + 1) % capacity] <= t - span) {
+        first++;
+    }
+    if (last - first == capacity) {
+        grow();
+    }
+    unsigned int slot = last % capacity;
+    times[slot] = t;
+    std::copy_n(y.begin(), dimension, values.begin() + slot * dimension);
+    std::copy_n(dydt.begin(), dimension, derivatives.begin() + slot * dimension);
+    last++;
+}
+
+void HistoryBuffer::evaluate(double t, std::vector<double>& y, unsigned long& cursor) const {
+    if (last == first || t < oldest() || t > newest()) {
+        throw std::out_of_range("Time is outside of the history buffer");
+    }
+    if (last - first == 1) {
+        std::copy_n(values.begin() + (first % capacity) * dimension, dimension, y.begin());
+        return;
+    }
+    // Interval [cursor, cursor + 1] containing t
+    cursor = std::clamp(cursor, first, last - 2);
+    while (cursor > first && t < times[cursor % capacity]) {
+        cursor--;
+    }
+    while (cursor + 2 < last && t > times[(cursor + 1) % capacity]) {
+        cursor++;
+    }
+    const unsigned int a = cursor % capacity;
+    const unsigned int b = (cursor + 1) % capacity;
+    const double h = times[b] - times[a];
+    const double s = (t - times[a]) / h;
+    const double h00 = (1 + 2 * s) * (1 - s) * (1 - s);
+    const double h10 = s * (1 - s) * (1 - s) * h;
+    const double h01 = s * s * (3 - 2 * s);
+    const double h11 = s * s * (s - 1) * h;
+    for (unsigned int i = 0; i < dimension; i++) {
+        y[i] = h00 * values[a * dimension + i] + h10 * derivatives[a * dimension + i]
+               + h01 * values[b * dimension + i] + h11 * derivatives[b * dimension + i];
+    }
+}
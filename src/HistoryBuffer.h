@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * @brief Ring buffer of the recent past of a solution, (t, y, y') at the accepted steps, evaluated by cubic Hermite
+ * interpolation.
+ *
+ * Points older than the span behind the newest point are dropped as new points arrive, so the memory is bounded by
+ * the span divided by the smallest step. The buffer only grows when the steps shrink below those it was sized for.
+ * Lookups take a cursor that is moved from the previous position, so a sequence of nondecreasing times, as produced
+ * by a fixed delay, costs O(1) amortized per lookup.
+ */
+class HistoryBuffer {
+
+public:
+    /**
+     * @brief Construct a HistoryBuffer object
+     *
+     * @param dimension  Size of y
+     * @param span       Length of the past that has to stay available, e.g. the maximum delay
+     * @param capacity   Initial number of points
+     */
+    HistoryBuffer(unsigned int dimension, double span, unsigned int capacity);
+
+    /**
+     * @brief Appends a point, t has to be larger than the time of the newest point.
+     */
+    void push(double t, const std::vector<double>& y, const std::vector<double>& dydt);
+
+    /**
+     * @brief Interpolates y at time t between the oldest and the newest point.
+     * @param t      Time
+     * @param y      Output, of size dimension
+     * @param cursor Position of the previous lookup, updated, 0 for a new sequence of lookups
+     */
+    void evaluate(double t, std::vector<double>& y, unsigned long& cursor) const;
+
+    /**
+     * @brief Time of the oldest point.
+     */
+    double oldest() const { return times[first % capacity]; }
+
+    /**
+     * @brief Time of the newest point.
+     */
+    double newest() const { return times[(last - 1) % capacity]; }
+
+    /**
+     * @brief Number of stored points.
+     */
+    unsigned int size() const { return last - first; }
+
+private:
+    unsigned int dimension;
+    double span;
+    unsigned int capacity;
+    // Points first, ..., last - 1 in the order of arrival, point a at slot a % capacity
+    unsigned long first = 0;
+    unsigned long last = 0;
+    std::vector<double> times;
+    std::vector<double> values;
+    std::vector<double> derivatives;
+
+    void grow();
+};
@@ -0,0 +1,65 @@
+#include "ILU0.h"
+#include <stdexcept>
+
+void ILU0::factorize(const CSRMatrix& A) {
+    if (A.rows != A.cols) {
+        throw std::invalid_argument("ILU0 requires a square matrix");
+    }
+    const unsigned int n = A.rows;
+    if (lu.rowPtr != A.rowPtr || lu.colIdx != A.colIdx) {
+        lu = A;
+        diagPos.resize(n);
+        for (unsigned int i = 0; i < n; i++) {
+            int pos = A.find(i, i);
+            if (pos < 0) {
+                throw std::invalid_argument("ILU0 requires the diagonal in the pattern");
+            }
+            diagPos[i] = pos;
+        }
+        position.assign(n, -1);
+    } else {
+        lu.values = A.values;
+    }
+
+    // Row-wise (IKJ) elimination that drops all updates outside the pattern of A
+    for (unsigned int i = 0; i < n; i++) {
+        for (unsigned int p = lu.rowPtr[i]; p < lu.rowPtr[i + 1]; p++) {
+            position[lu.colIdx[p]] = p;
+        }
+        for (unsigned int p = lu.rowPtr[i]; p < diagPos[i]; p++) {
+            unsigned int k = lu.colIdx[p];
+            double l_ik = lu.values[p] / lu.values[diagPos[k]];
+            lu.values[p] = l_ik;
+            for (unsigned int q = diagPos[k] + 1; q < lu.rowPtr[k + 1]; q++) {
+                int target = position[lu.colIdx[q]];
+                if (target >= 0) {
+                    lu.values[target] -= l_ik * lu.values[q];
+                }
+            }
+        }
+        if (lu.values[diagPos[i]] == 0.0) {
+            throw std::runtime_error("Zero pivot in ILU0 factorization");
+        }
+        for (unsigned int p = lu.rowPtr[i]; p < lu.rowPtr[i + 1]; p++) {
+            position[lu.colIdx[p]] = -1;
+        }
+    }
+}
+
+void ILU0::solve(std::vector<double>& b) const {
+    const unsigned int n = lu.rows;
+    for (unsigned int i = 0; i < n; i++) {
+        double sum = b[i];
+        for (unsigned int p = lu.rowPtr[i]; p < diagPos[i]; p++) {
+            sum -= lu.values[p] * b[lu.colIdx[p]];
+        }
+        b[i] = sum;
+    }
+    for (unsigned int i = n; i-- > 0;) {
+        double sum = b[i];
+        for (unsigned int p = diagPos[i] + 1; p < lu.rowPtr[i + 1]; p++) {
+            sum -= lu.values[p] * b[lu.colIdx[p]];
+        }
+        b[i] = sum / lu.values[diagPos[i]];
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vector>
+#include "SparseMatrix.h"
+
+/**
+ * @brief Incomplete LU factorization without fill-in, ILU(0), of a square CSR matrix.
+ *
+ * L and U are restricted to the pattern of A, which has to contain the diagonal. The factors are stored in a
+ * copy of A, so a factorization costs no allocations when the pattern stays the same.
+ */
+class ILU0 {
+
+public:
+    /**
+     * @brief Computes the incomplete factorization of A.
+     * @param A Square matrix whose pattern includes the diagonal.
+     */
+    void factorize(const CSRMatrix& A);
+
+    /**
+     * @brief Overwrites b with (L U)^-1 b.
+     */
+    void solve(std::vector<double>& b) const;
+
+private:
+    CSRMatrix lu;
+    std::vector<unsigned int> diagPos;
+    std::vector<int> position;
+};
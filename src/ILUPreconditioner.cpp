@@ -0,0 +1,10 @@
+#include "ILUPreconditioner.h"
+
+void ILUPreconditioner::setup(const std::vector<double>& y, double t, double gamma) {
+    jacobian(y, t, J);
+    ilu.factorize(newtonMatrix.assemble(J, gamma));
+}
+
+void ILUPreconditioner::apply(std::vector<double>& v) {
+    ilu.solve(v);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+#include "Preconditioner.h"
+#include "SparseNewtonMatrix.h"
+#include "ILU0.h"
+
+/**
+ * @brief ILU(0) preconditioner of the Newton matrix I - gamma * J with a sparse Jacobian.
+ *
+ */
+class ILUPreconditioner : public Preconditioner {
+
+public:
+    /**
+     * @brief Construct an ILUPreconditioner object
+     *
+     * @param jacobian Such that jacobian(y, t) = df(y, t)/dy
+     */
+    explicit ILUPreconditioner(SparseJacobianFunction jacobian) : jacobian(std::move(jacobian)) {}
+
+    void setup(const std::vector<double>& y, double t, double gamma) override;
+
+    void apply(std::vector<double>& v) override;
+
+private:
+    SparseJacobianFunction jacobian;
+    CSRMatrix J;
+    SparseNewtonMatrix newtonMatrix;
+    ILU0 ilu;
+};
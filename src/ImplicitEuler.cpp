@@ -6,16 +6,13 @@ std::vector<double> ImplicitEuler::solve(double stepSize, double tEnd) {
     std::vector<double> y;
     y.reserve(N);
     y.push_back(y0);
-    auto g = [&y, &t, stepSize, this](double x) {
-        return stepSize * f(x, t + stepSize) + y.back() - x;
-    };
-    auto dg = [&t, stepSize, this](double x) {
-        return stepSize * df(x, t + stepSize) - 1;
-    };
     for (int n = 1; n < N; n++) {
-        auto [y_new, converged] = NewtonRaphson(y.back(), g, dg);
+        auto [y_new, converged] = implicitEulerStep(y.back(), t + stepSize, stepSize, predict(y));
         if (converged) {
             y.push_back(y_new);
+            if (events && stopAtEvent(y, t0 + (n - 1) * stepSize, t0 + n * stepSize)) {
+                break;
+            }
             t = t0 + n * stepSize;
         } else {
             std::cout << "Newton-Raphson method did not converge" << std::endl;
@@ -0,0 +1,41 @@
+#include "ImplicitEulerSystem.h"
+
+std::vector<std::vector<double>> ImplicitEulerSystem::solve(double stepSize, double tEnd) {
+    if (mass && events) {
+        throw std::invalid_argument("Events are not supported together with a mass matrix");
+    }
+    double t = t0;
+    unsigned int N = ceil((tEnd - t0) / stepSize) + 1;
+    std::vector<std::vector<double>> y;
+    y.reserve(N);
+    y.push_back(y0);
+    initializeAlgebraicVariables(y.back(), t0);
+    sensitivityValues.clear();
+    if (parameterJacobian) {
+        sensitivityValues.reserve(N);
+        sensitivityValues.push_back(sensitivityStart);
+    }
+    for (int n = 1; n < N; n++) {
+        std::vector<double> y_new = predict(y);
+        if (Newton(y_new, y.back(), t + stepSize, stepSize)) {
+            if (parameterJacobian) {
+                std::vector<double> S = sensitivityValues.back();
+                sensitivityStep(y_new, t + stepSize, stepSize, S);
+                sensitivityValues.push_back(std::move(S));
+            }
+            y.push_back(std::move(y_new));
+            if (events && stopAtEvent(y, t0 + (n - 1) * stepSize, t0 + n * stepSize)) {
+                // A terminal event inside the step drops the state, and with it its sensitivities
+                if (sensitivityValues.size() > y.size()) {
+                    sensitivityValues.pop_back();
+                }
+                break;
+            }
+            t = t0 + n * stepSize;
+        } else {
+            std::cout << "Newton method did not converge" << std::endl;
+            break;
+        }
+    }
+    return y;
+}
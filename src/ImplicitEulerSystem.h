@@ -0,0 +1,47 @@
+#pragma once
+
+#include "ImplicitSystemSolver.h"
+#include <utility>
+#include <vector>
+#include <iostream>
+#include <cmath>
+
+/**
+ * @brief Class for solving systems of ODEs using the Implicit Euler method.
+ *
+ * Also solves M(y, t) y' = f(y, t) with a mass matrix (see setMassMatrix), including DAEs of index 1, for which
+ * backward Euler is stiffly accurate: every step satisfies the algebraic equations. Forward sensitivities with
+ * respect to parameters are computed along with the solution after setSensitivities.
+ */
+class ImplicitEulerSystem : public ImplicitSystemSolver {
+public:
+    /**
+     * @brief Construct an ImplicitEulerSystem object using the dense linear solver
+     *
+     * @param  f         Such that y' = f(y, t)
+     * @param  y0        Initial value of y
+     * @param  t0        Initial value of t
+     * @param  jacobian  Such that jacobian(y, t) = df(y, t)/dy
+     */
+    ImplicitEulerSystem(SystemFunction f, std::vector<double> y0, double t0, DenseJacobianFunction jacobian)
+            : ImplicitSystemSolver(std::move(f), std::move(y0), t0, std::move(jacobian)) {}
+
+    /**
+     * @brief Construct an ImplicitEulerSystem object
+     *
+     * @param  f             Such that y' = f(y, t)
+     * @param  y0            Initial value of y
+     * @param  t0            Initial value of t
+     * @param  linearSolver  Solver for the Newton systems
+     */
+    ImplicitEulerSystem(SystemFunction f, std::vector<double> y0, double t0, std::unique_ptr<LinearSolver> linearSolver)
+            : ImplicitSystemSolver(std::move(f), std::move(y0), t0, std::move(linearSolver)) {}
+
+    /**
+     * @brief Solves the system of ODEs using the Implicit Euler method.
+     * @param stepSize The step size.
+     * @param tEnd The time to solve the ODE to.
+     * @return A vector of the solution vector at each step.
+     */
+    std::vector<std::vector<double>> solve(double stepSize, double tEnd) override;
+};
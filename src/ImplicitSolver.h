@@ -1,12 +1,17 @@
 #pragma once
 
+#include <atomic>
 #include <utility>
+#include <stdexcept>
 
 #include "ODESolver.h"
+#include "utilities.h"
 
 /**
  * @brief Abstract interface for solving ODEs using implicit methods.
  *
+ * Newton is started from a polynomial extrapolation of the last accepted values (quadratic by default), which
+ * saves iterations on smooth solutions.
  */
 class ImplicitSolver : public ODESolver {
 
@@ -14,6 +19,10 @@ protected:
     std::function<double(double y, double t)> df;
     const double tol = 1e-8;
     const unsigned int maxIter = 1000;
+    std::vector<double> predictorWeights = utilities::extrapolationWeights(3);
+    // Atomic, since derived solvers may solve on several threads
+    std::atomic<unsigned long> newtonIterations = 0;
+    std::atomic<unsigned long> newtonSolves = 0;
 
 protected:
     /**
@@ -37,7 +46,7 @@ protected:
     * @return A pair containing the solution and a boolean indicating if the method converged
     */
     std::pair<double, bool>
-    NewtonRaphson(double x0, const std::function<double(double)>& g, const std::function<double(double)>& dg) const {
+    NewtonRaphson(double x0, const std::function<double(double)>& g, const std::function<double(double)>& dg) {
         double x_old = x0;
         double x_new = x0;
         unsigned int N = 0;
@@ -45,6 +54,61 @@ protected:
             x_old = x_new;
             x_new = x_old - g(x_old) / dg(x_old);
         }
+        newtonIterations += N;
+        newtonSolves++;
         return {x_new, N != maxIter};
     }
+
+    /**
+     * @brief Implicit Euler step, solves x = base + stepSize * f(x, t) with the Newton-Raphson method.
+     * @param base Constant part of the equation, the last value for a plain implicit Euler step
+     * @param t Time at the end of the step
+     * @param stepSize The step size
+     * @param guess Initial guess of Newton-Raphson
+     * @return A pair containing the solution and a boolean indicating if the method converged
+     */
+    std::pair<double, bool> implicitEulerStep(double base, double t, double stepSize, double guess) {
+        auto g = [base, t, stepSize, this](double x) {
+            return stepSize * f(x, t) + base - x;
+        };
+        auto dg = [t, stepSize, this](double x) {
+            return stepSize * df(x, t) - 1;
+        };
+        return NewtonRaphson(guess, g, dg);
+    }
+
+    /**
+     * @brief Predicts the next value by polynomial extrapolation of the last accepted values, used as Newton guess.
+     * @param y The accepted values so far, at equidistant times.
+     * @return The predicted value at the next time.
+     */
+    double predict(const std::vector<double>& y) const {
+        if (y.size() < predictorWeights.size()) {
+            return y.back();
+        }
+        double prediction = 0.0;
+        for (unsigned int j = 0; j < predictorWeights.size(); j++) {
+            prediction += predictorWeights[j] * y[y.size() - 1 - j];
+        }
+        return prediction;
+    }
+
+public:
+    /**
+     * @brief Sets the number of past values extrapolated to the Newton initial guess, 1 starts from the last value.
+     * @param k Number of past values
+     */
+    void setPredictorOrder(unsigned int k) {
+        if (k == 0) {
+            throw std::invalid_argument("Predictor order must be positive");
+        }
+        predictorWeights = utilities::extrapolationWeights(k);
+    }
+
+    /**
+     * @brief Average number of Newton iterations per solved nonlinear equation.
+     */
+    double averageNewtonIterations() const {
+        return newtonSolves == 0 ? 0.0 : static_cast<double>(newtonIterations) / newtonSolves;
+    }
 };
\ No newline at end of file
@@ -0,0 +1,327 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "ODESystemSolver.h"
+#include "LinearSolver.h"
+#include "DenseLinearSolver.h"
+#include "utilities.h"
+
+/**
+ * @brief Derivatives of the right hand side with respect to parameters, writes df(y, t)/dp row-major into dfdp, i.e.
+ * dfdp[i * parameters + j] = df_i/dp_j.
+ */
+using ParameterJacobianFunction = std::function<void(const std::vector<double>& y, double t,
+                                                     std::vector<double>& dfdp)>;
+
+/**
+ * @brief Abstract interface for solving systems of ODEs using implicit methods.
+ *
+ * The nonlinear stage equations are solved with a simplified Newton method. The factorized Newton matrix is kept
+ * across iterations and steps as long as gamma does not change and Newton keeps converging, it is only
+ * recomputed when convergence stalls. Linear solvers that do not reuse setups are set up in every iteration,
+ * which turns the iteration into a full (inexact) Newton method. Newton is started from a polynomial
+ * extrapolation of the last accepted values (quadratic by default).
+ *
+ * With a mass matrix the system is M(y, t) y' = f(y, t). A singular M gives differential-algebraic equations (DAEs),
+ * which are supported up to index 1 by methods that call initializeAlgebraicVariables, i.e. ImplicitEulerSystem.
+ *
+ * Forward sensitivities S = dy/dp with respect to parameters p of f follow from S' = J S + df/dp. Methods that call
+ * sensitivityStep (ImplicitEulerSystem) propagate them with the discrete derivative of the step: after the step the
+ * Newton matrix is set up once at the new value and this factorization is used for all parameters in one batched
+ * solve and again by the Newton iterations of the next step.
+ */
+class ImplicitSystemSolver : public ODESystemSolver {
+
+protected:
+    std::unique_ptr<LinearSolver> linearSolver;
+    const double tol = 1e-8;
+    const unsigned int maxIter = 50;
+    std::vector<double> predictorWeights = utilities::extrapolationWeights(3);
+    unsigned long newtonIterations = 0;
+    unsigned long newtonSolves = 0;
+    MassMatrixFunction mass;
+    ParameterJacobianFunction parameterJacobian;
+    unsigned int parameters = 0;
+    std::vector<double> sensitivityStart;
+    std::vector<std::vector<double>> sensitivityValues;
+
+private:
+    bool hasSetup = false;
+    double setupGamma = 0.0;
+    std::vector<double> residual;
+    std::vector<double> xStart;
+    bool constantMass = true;
+    CSRMatrix massMatrix;
+    std::vector<double> difference;
+    std::vector<double> massProduct;
+    std::vector<double> parameterDerivative;
+
+protected:
+    /**
+     * @brief Construct an object derived from ImplicitSystemSolver using the dense linear solver.
+     *
+     * @param  f         Such that y' = f(y, t)
+     * @param  y0        Initial value of y
+     * @param  t0        Initial value of t
+     * @param  jacobian  Such that jacobian(y, t) = df(y, t)/dy
+     */
+    ImplicitSystemSolver(SystemFunction f, std::vector<double> y0, double t0, DenseJacobianFunction jacobian)
+            : ODESystemSolver(std::move(f), std::move(y0), t0),
+              linearSolver(std::make_unique<DenseLinearSolver>(std::move(jacobian))) {}
+
+    /**
+     * @brief Construct an object derived from ImplicitSystemSolver.
+     *
+     * @param  f             Such that y' = f(y, t)
+     * @param  y0            Initial value of y
+     * @param  t0            Initial value of t
+     * @param  linearSolver  Solver for the Newton systems
+     */
+    ImplicitSystemSolver(SystemFunction f, std::vector<double> y0, double t0, std::unique_ptr<LinearSolver> linearSolver)
+            : ODESystemSolver(std::move(f), std::move(y0), t0), linearSolver(std::move(linearSolver)) {}
+
+    /**
+    * @brief Simplified Newton method for x = base + gamma * f(x, t), or M(x, t) (x - base) = gamma * f(x, t) with a
+    * mass matrix
+    * @param x     Initial guess, overwritten with the solution
+    * @param base  Constant part of the equation
+    * @param t     Time at which f is evaluated
+    * @param gamma Scaling of f
+    * @const tol The allowable relative size of the Newton update
+    * @const maxIter Maximum number of iterations
+    * @return Whether the method converged
+    */
+    bool Newton(std::vector<double>& x, const std::vector<double>& base, double t, double gamma) {
+        const bool reuse = linearSolver->reusesSetup();
+        bool fresh = false;
+        if (reuse && (!hasSetup || gamma != setupGamma)) {
+            linearSolver->setup(x, t, gamma);
+            hasSetup = true;
+            setupGamma = gamma;
+            fresh = true;
+        }
+        xStart = x;
+        residual.resize(x.size());
+        newtonSolves++;
+        while (true) {
+            double previousNorm = INFINITY;
+            for (unsigned int N = 0; N < maxIter; N++) {
+                if (!reuse) {
+                    linearSolver->setup(x, t, gamma);
+                }
+                f(x, t, residual);
+                if (mass) {
+                    if (!constantMass || massMatrix.rows == 0) {
+                        mass(x, t, massMatrix);
+                    }
+                    difference.resize(x.size());
+                    for (unsigned int i = 0; i < x.size(); i++) {
+                        difference[i] = base[i] - x[i];
+                    }
+                    massMatrix.multiply(difference, massProduct);
+                    for (unsigned int i = 0; i < x.size(); i++) {
+                        residual[i] = massProduct[i] + gamma * residual[i];
+                    }
+                } else {
+                    for (unsigned int i = 0; i < x.size(); i++) {
+                        residual[i] = base[i] + gamma * residual[i] - x[i];
+                    }
+                }
+                linearSolver->solve(residual);
+                newtonIterations++;
+                double norm = 0.0;
+                double scale = 0.0;
+                for (unsigned int i = 0; i < x.size(); i++) {
+                    x[i] += residual[i];
+                    norm = std::max(norm, std::abs(residual[i]));
+                    scale = std::max(scale, std::abs(x[i]));
+                }
+                if (norm <= tol * (1 + scale)) {
+                    return true;
+                }
+                if (N > 0 && norm > 0.9 * previousNorm) {
+                    break;
+                }
+                previousNorm = norm;
+            }
+            if (fresh || !reuse) {
+                return false;
+            }
+            // Convergence stalled with an outdated Newton matrix, retry with a fresh one
+            x = xStart;
+            linearSolver->setup(x, t, gamma);
+            fresh = true;
+        }
+    }
+
+    /**
+     * @brief Makes the algebraic components of y consistent with the algebraic equations at t.
+     *
+     * The algebraic components are those whose columns of M(y, t) are zero. They are taken from a backward Euler
+     * step of negligible size, which solves the algebraic equations for them while the differential components stay
+     * put up to the step size. Without a mass matrix or without algebraic components y is left unchanged.
+     * @param y Initial value, overwritten with a consistent one
+     * @param t Initial time
+     */
+    void initializeAlgebraicVariables(std::vector<double>& y, double t) {
+        if (!mass) {
+            return;
+        }
+        mass(y, t, massMatrix);
+        std::vector<bool> algebraic(y.size(), true);
+        for (unsigned int p = 0; p < massMatrix.nonZeros(); p++) {
+            if (massMatrix.values[p] != 0.0) {
+                algebraic[massMatrix.colIdx[p]] = false;
+            }
+        }
+        if (std::find(algebraic.begin(), algebraic.end(), true) == algebraic.end()) {
+            return;
+        }
+        std::vector<double> x = y;
+        if (!Newton(x, y, t, 1e-10 * std::max(1.0, std::abs(t)))) {
+            throw std::runtime_error("Consistent initialization of the algebraic variables did not converge");
+        }
+        for (unsigned int i = 0; i < y.size(); i++) {
+            if (algebraic[i]) {
+                y[i] = x[i];
+            }
+        }
+    }
+
+    /**
+     * @brief Propagates the sensitivities over a step x = base + gamma * f(x, t), i.e. solves
+     * (I - gamma * J(x, t)) S = SBase + gamma * df(x, t)/dp, or M S = M SBase + ... with a mass matrix.
+     *
+     * Exact for the discrete step with a constant mass matrix, the derivative of a state dependent M is neglected.
+     * @param x     Solution of the step
+     * @param t     Time at which f is evaluated
+     * @param gamma Scaling of f
+     * @param S     Sensitivities at base row-major (S[i * parameters + j] = dy_i/dp_j), overwritten with those at x
+     */
+    void sensitivityStep(const std::vector<double>& x, double t, double gamma, std::vector<double>& S) {
+        linearSolver->setup(x, t, gamma);
+        hasSetup = true;
+        setupGamma = gamma;
+        const unsigned int n = x.size();
+        parameterDerivative.assign(static_cast<std::size_t>(n) * parameters, 0.0);
+        parameterJacobian(x, t, parameterDerivative);
+        if (mass) {
+            if (!constantMass || massMatrix.rows == 0) {
+                mass(x, t, massMatrix);
+            }
+            massProduct.assign(static_cast<std::size_t>(n) * parameters, 0.0);
+            for (unsigned int i = 0; i < n; i++) {
+                double* row = massProduct.data() + static_cast<std::size_t>(i) * parameters;
+                for (unsigned int p = massMatrix.rowPtr[i]; p < massMatrix.rowPtr[i + 1]; p++) {
+                    const double* source = S.data() + static_cast<std::size_t>(massMatrix.colIdx[p]) * parameters;
+                    for (unsigned int j = 0; j < parameters; j++) {
+                        row[j] += massMatrix.values[p] * source[j];
+                    }
+                }
+            }
+            S.swap(massProduct);
+        }
+        for (std::size_t k = 0; k < S.size(); k++) {
+            S[k] += gamma * parameterDerivative[k];
+        }
+        linearSolver->solve(S, parameters);
+    }
+
+    /**
+     * @brief Predicts the next value by polynomial extrapolation of the last accepted values, used as Newton guess.
+     * @param y The accepted values so far, at equidistant times.
+     * @return The predicted value at the next time.
+     */
+    std::vector<double> predict(const std::vector<std::vector<double>>& y) const {
+        if (y.size() < predictorWeights.size()) {
+            return y.back();
+        }
+        std::vector<double> prediction(y.back().size(), 0.0);
+        for (unsigned int j = 0; j < predictorWeights.size(); j++) {
+            const std::vector<double>& past = y[y.size() - 1 - j];
+            for (unsigned int i = 0; i < prediction.size(); i++) {
+                prediction[i] += predictorWeights[j] * past[i];
+            }
+        }
+        return prediction;
+    }
+
+public:
+    /**
+     * @brief Sets the number of past values extrapolated to the Newton initial guess, 1 starts from the last value.
+     * @param k Number of past values
+     */
+    void setPredictorOrder(unsigned int k) {
+        if (k == 0) {
+            throw std::invalid_argument("Predictor order must be positive");
+        }
+        predictorWeights = utilities::extrapolationWeights(k);
+    }
+
+    /**
+     * @brief Solves M(y, t) y' = f(y, t) instead of y' = f(y, t), the linear solver has to support mass matrices.
+     *
+     * A singular M, e.g. with zero rows for algebraic equations 0 = g(y, t), gives a DAE of index 1 if the Jacobian
+     * of the algebraic equations with respect to the algebraic components is regular. The initial values of the
+     * algebraic components are only a guess, they are made consistent at the start of solve.
+     * @param mass      The mass matrix
+     * @param constant  Whether M does not depend on y and t, it is then evaluated once per Newton matrix
+     */
+    void setMassMatrix(MassMatrixFunction mass, bool constant = true) {
+        linearSolver->setMassMatrix(mass);
+        this->mass = std::move(mass);
+        constantMass = constant;
+        massMatrix = CSRMatrix();
+        hasSetup = false;
+    }
+
+    /**
+     * @brief With a mass matrix f is not y', the derivatives of the dense output are differences of the values.
+     */
+    DenseOutput solveDense(double stepSize, double tEnd,
+                           DenseOutput::Order order = DenseOutput::Order::Cubic) override {
+        if (mass) {
+            return DenseOutput::fromValues(t0, stepSize, solve(stepSize, tEnd), order);
+        }
+        return ODESystemSolver::solveDense(stepSize, tEnd, order);
+    }
+
+    /**
+     * @brief Computes the sensitivities dy/dp of the solution with respect to parameters along with it.
+     *
+     * All parameters are propagated together, sharing the Jacobian evaluations and factorizations with the state,
+     * which is much cheaper than differencing whole solves. Only methods calling sensitivityStep support it.
+     * @param dfdp        Such that dfdp(y, t) = df(y, t)/dp
+     * @param parameters  Number of parameters
+     * @param s0          dy0/dp row-major, zero if empty
+     */
+    void setSensitivities(ParameterJacobianFunction dfdp, unsigned int parameters, std::vector<double> s0 = {}) {
+        if (parameters == 0) {
+            throw std::invalid_argument("Sensitivities need at least one parameter");
+        }
+        if (!s0.empty() && s0.size() != y0.size() * parameters) {
+            throw std::invalid_argument("Initial sensitivities do not match the number of parameters");
+        }
+        parameterJacobian = std::move(dfdp);
+        this->parameters = parameters;
+        sensitivityStart = s0.empty() ? std::vector<double>(y0.size() * parameters, 0.0) : std::move(s0);
+    }
+
+    /**
+     * @brief The sensitivities of the last solve at each step, row-major as the initial sensitivities.
+     */
+    const std::vector<std::vector<double>>& sensitivities() const { return sensitivityValues; }
+
+    /**
+     * @brief Average number of Newton iterations per solved nonlinear system.
+     */
+    double averageNewtonIterations() const {
+        return newtonSolves == 0 ? 0.0 : static_cast<double>(newtonIterations) / newtonSolves;
+    }
+};
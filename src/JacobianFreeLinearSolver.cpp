@@ -0,0 +1,79 @@
+#include "JacobianFreeLinearSolver.h"
+#include <chrono>
+#include <cmath>
+
+/**
+ * @brief Seconds elapsed since start.
+ */
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void JacobianFreeLinearSolver::setup(const std::vector<double>& y, double t, double gamma) {
+    if (preconditioner) {
+        if (rebuildPreconditioner || gamma != this->gamma || ++preconditionerAge > maxAge) {
+            auto start = std::chrono::steady_clock::now();
+            preconditioner->setup(y, t, gamma);
+            stats.preconditionerSetupTime += secondsSince(start);
+            stats.preconditionerSetups++;
+            preconditionerAge = 0;
+            rebuildPreconditioner = false;
+        }
+    }
+    this->y = y;
+    this->t = t;
+    this->gamma = gamma;
+    yNorm = 0.0;
+    for (double value: y) {
+        yNorm += value * value;
+    }
+    yNorm = std::sqrt(yNorm);
+    fy.resize(y.size());
+    shifted.resize(y.size());
+    fShifted.resize(y.size());
+    f(y, t, fy);
+    stats.rhsEvaluations++;
+}
+
+void JacobianFreeLinearSolver::solve(std::vector<double>& b) {
+    const unsigned int n = b.size();
+    auto newtonMatrix = [this, n](const std::vector<double>& v, std::vector<double>& Av) {
+        double vNorm = 0.0;
+        for (double value: v) {
+            vNorm += value * value;
+        }
+        vNorm = std::sqrt(vNorm);
+        Av.resize(n);
+        if (vNorm == 0.0) {
+            std::fill(Av.begin(), Av.end(), 0.0);
+            return;
+        }
+        double eps = std::sqrt(1e-16) * (1 + yNorm) / vNorm;
+        for (unsigned int i = 0; i < n; i++) {
+            shifted[i] = y[i] + eps * v[i];
+        }
+        f(shifted, t, fShifted);
+        stats.rhsEvaluations++;
+        for (unsigned int i = 0; i < n; i++) {
+            Av[i] = v[i] - gamma * (fShifted[i] - fy[i]) / eps;
+        }
+    };
+    GMRES::Preconditioner apply = nullptr;
+    if (preconditioner) {
+        apply = [this](std::vector<double>& v) {
+            auto start = std::chrono::steady_clock::now();
+            preconditioner->apply(v);
+            stats.preconditionerApplyTime += secondsSince(start);
+            stats.preconditionerApplies++;
+        };
+    }
+    x.assign(n, 0.0);
+    bool converged = gmres.solve(newtonMatrix, b, x, apply);
+    stats.linearSolves++;
+    stats.krylovIters += gmres.iterations();
+    if (!converged) {
+        stats.failures++;
+        rebuildPreconditioner = true;
+    }
+    b.swap(x);
+}
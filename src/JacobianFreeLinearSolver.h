@@ -0,0 +1,90 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include "LinearSolver.h"
+#include "Preconditioner.h"
+#include "ODESystemSolver.h"
+#include "GMRES.h"
+
+/**
+ * @brief Jacobian-free Newton-Krylov solver for the Newton systems of implicit methods.
+ *
+ * The Jacobian is never formed: products with it are approximated by directional differences
+ * J v ~ (f(y + eps v, t) - f(y, t)) / eps and the systems are solved with restarted GMRES. The memory therefore
+ * scales with the Krylov dimension instead of n^2. A setup costs a single evaluation of f, so the linearization
+ * point is updated in every Newton iteration.
+ *
+ * The preconditioner is set up far less often: it is kept across Newton iterations and steps and only rebuilt
+ * when gamma changes, when a Krylov solve fails or after maxAge setups.
+ */
+class JacobianFreeLinearSolver : public LinearSolver {
+
+public:
+    /**
+     * @brief Work done by the Krylov solves and the preconditioner.
+     *
+     * @param linearSolves              Number of solved linear systems
+     * @param krylovIters               Number of GMRES iterations over all solves
+     * @param rhsEvaluations            Number of evaluations of f for setups and Jacobian-vector products
+     * @param failures                  Number of solves that did not reach the requested tolerance
+     * @param preconditionerSetups      Number of preconditioner setups
+     * @param preconditionerApplies     Number of preconditioner applications
+     * @param preconditionerSetupTime   Time spent in preconditioner setups in seconds
+     * @param preconditionerApplyTime   Time spent in preconditioner applications in seconds
+     */
+    struct Statistics {
+        unsigned long linearSolves = 0;
+        unsigned long krylovIters = 0;
+        unsigned long rhsEvaluations = 0;
+        unsigned long failures = 0;
+        unsigned long preconditionerSetups = 0;
+        unsigned long preconditionerApplies = 0;
+        double preconditionerSetupTime = 0.0;
+        double preconditionerApplyTime = 0.0;
+    };
+
+    /**
+     * @brief Construct a JacobianFreeLinearSolver object
+     *
+     * @param f               Such that y' = f(y, t)
+     * @param preconditioner  Optional preconditioner of I - gamma * J
+     * @param restart         Dimension of the Krylov space before restarting
+     * @param tol             Relative residual reduction of the linear solves
+     * @param maxAge          Number of setups after which the preconditioner is rebuilt even if gamma is unchanged
+     */
+    explicit JacobianFreeLinearSolver(SystemFunction f, std::unique_ptr<Preconditioner> preconditioner = nullptr,
+                                      unsigned int restart = 30, double tol = 1e-6, unsigned int maxAge = 100)
+            : f(std::move(f)), preconditioner(std::move(preconditioner)), gmres(restart, tol), maxAge(maxAge) {}
+
+    void setup(const std::vector<double>& y, double t, double gamma) override;
+
+    void solve(std::vector<double>& b) override;
+
+    using LinearSolver::solve;
+
+    bool reusesSetup() const override { return false; }
+
+    /**
+     * @brief Accumulated work of all solves.
+     */
+    const Statistics& statistics() const { return stats; }
+
+private:
+    SystemFunction f;
+    std::unique_ptr<Preconditioner> preconditioner;
+    GMRES gmres;
+    unsigned int maxAge;
+    unsigned int preconditionerAge = 0;
+    bool rebuildPreconditioner = true;
+    Statistics stats;
+    std::vector<double> y;
+    double t = 0.0;
+    double gamma = 0.0;
+    double yNorm = 0.0;
+    std::vector<double> fy;
+    std::vector<double> shifted;
+    std::vector<double> fShifted;
+    std::vector<double> x;
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <functional>
+#include <stdexcept>
+#include <vector>
+#include "SparseMatrix.h"
+
+/**
+ * @brief Mass matrix of a system M(y, t) y' = f(y, t) in CSR format, writes M(y, t) into M.
+ */
+using MassMatrixFunction = std::function<void(const std::vector<double>& y, double t, CSRMatrix& M)>;
+
+/**
+ * @brief Abstract interface for the linear systems with the Newton matrix I - gamma * J(y, t) of implicit methods.
+ *
+ */
+class LinearSolver {
+
+public:
+    /**
+     * @brief Prepares solving with the Newton matrix I - gamma * J(y, t), e.g. by assembling and factorizing it.
+     * @param y     Point at which the Jacobian is evaluated
+     * @param t     Time at which the Jacobian is evaluated
+     * @param gamma Scaling of the Jacobian
+     */
+    virtual void setup(const std::vector<double>& y, double t, double gamma) = 0;
+
+    /**
+     * @brief Solves (I - gamma * J) x = b with the matrix of the last setup.
+     * @param b Right hand side, overwritten with the solution.
+     */
+    virtual void solve(std::vector<double>& b) = 0;
+
+    /**
+     * @brief Solves (I - gamma * J) X = B for count right hand sides with the matrix of the last setup.
+     *
+     * The default solves the right hand sides one by one, solvers with a batched kernel override it.
+     * @param B     Right hand sides stored row-major (B[i * count + j] is row i of right hand side j), overwritten with
+     *              the solutions.
+     * @param count Number of right hand sides.
+     */
+    virtual void solve(std::vector<double>& B, unsigned int count) {
+        const std::size_t n = B.size() / count;
+        std::vector<double> b(n);
+        for (unsigned int j = 0; j < count; j++) {
+            for (std::size_t i = 0; i < n; i++) {
+                b[i] = B[i * count + j];
+            }
+            solve(b);
+            for (std::size_t i = 0; i < n; i++) {
+                B[i * count + j] = b[i];
+            }
+        }
+    }
+
+    /**
+     * @brief Whether a setup stays valid for later Newton iterations and steps with the same gamma.
+     *
+     * Solvers with a cheap setup, e.g. matrix-free ones, return false and are set up in every Newton iteration.
+     */
+    virtual bool reusesSetup() const { return true; }
+
+    /**
+     * @brief Makes the Newton matrix M(y, t) - gamma * J(y, t) instead of I - gamma * J(y, t).
+     * @param mass The mass matrix, evaluated in every setup
+     */
+    virtual void setMassMatrix(MassMatrixFunction) {
+        throw std::invalid_argument("Linear solver does not support mass matrices");
+    }
+
+    virtual ~LinearSolver() {} ;
+};
@@ -0,0 +1,129 @@
+#include "MatrixFunctions.h"
+#include <algorithm>
+#include <cmath>
+#include "DenseLU.h"
+
+namespace matrixFunctions {
+    std::vector<double> multiply(const std::vector<double>& A, const std::vector<double>& B, unsigned int n) {
+        std::vector<double> C(static_cast<std::size_t>(n) * n, 0.0);
+        for (unsigned int i = 0; i < n; i++) {
+            for (unsigned int k = 0; k < n; k++) {
+                double a = A[i * n + k];
+                if (a == 0.0) {
+                    continue;
+                }
+                for (unsigned int j = 0; j < n; j++) {
+                    C[i * n + j] += a * B[k * n + j];
+                }
+            }
+        }
+        return C;
+    }
+
+    std::vector<double> exponential(const std::vector<double>& A, unsigned int n) {
+        const unsigned int q = 6;
+        double norm = 0.0;
+        for (unsigned int i = 0; i < n; i++) {
+            double rowSum = 0.0;
+            for (unsigned int j = 0; j < n; j++) {
+                rowSum += std::abs(A[i * n + j]);
+            }
+            norm = std::max(norm, rowSum);
+        }
+        int squarings = norm > 0.0 ? std::max(0, static_cast<int>(std::floor(std::log2(norm))) + 2) : 0;
+        double scale = std::ldexp(1.0, -squarings);
+
+        std::vector<double> X(A.size());
+        for (unsigned int i = 0; i < A.size(); i++) {
+            X[i] = A[i] * scale;
+        }
+        // Numerator N and denominator D of the Pade approximant, D(X) = N(-X)
+        std::vector<double> numerator(A.size(), 0.0);
+        std::vector<double> denominator(A.size(), 0.0);
+        std::vector<double> power(A.size(), 0.0);
+        for (unsigned int i = 0; i < n; i++) {
+            power[i * n + i] = 1.0;
+        }
+        double c = 1.0;
+        for (unsigned int k = 0; k <= q; k++) {
+            if (k > 0) {
+                c = c * (q - k + 1) / (k * (2 * q - k + 1));
+                power = multiply(power, X, n);
+            }
+            double sign = k % 2 == 0 ? 1.0 : -1.0;
+            for (unsigned int i = 0; i < A.size(); i++) {
+                numerator[i] += c * power[i];
+                denominator[i] += sign * c * power[i];
+            }
+        }
+        DenseLU lu;
+        lu.factorize(denominator, n);
+        std::vector<double> E(A.size());
+        std::vector<double> column(n);
+        for (unsigned int j = 0; j < n; j++) {
+            for (unsigned int i = 0; i < n; i++) {
+                column[i] = numerator[i * n + j];
+            }
+            lu.solve(column);
+            for (unsigned int i = 0; i < n; i++) {
+                E[i * n + j] = column[i];
+            }
+        }
+        for (int s = 0; s < squarings; s++) {
+            E = multiply(E, E, n);
+        }
+        return E;
+    }
+
+    std::vector<std::vector<double>> phi(const std::vector<double>& Z, unsigned int n, unsigned int p) {
+        const unsigned int m = (p + 1) * n;
+        std::vector<double> augmented(static_cast<std::size_t>(m) * m, 0.0);
+        for (unsigned int i = 0; i < n; i++) {
+            for (unsigned int j = 0; j < n; j++) {
+                augmented[i * m + j] = Z[i * n + j];
+            }
+        }
+        for (unsigned int block = 0; block < p; block++) {
+            for (unsigned int i = 0; i < n; i++) {
+                augmented[(block * n + i) * m + (block + 1) * n + i] = 1.0;
+            }
+        }
+        std::vector<double> E = exponential(augmented, m);
+        std::vector<std::vector<double>> result(p + 1, std::vector<double>(static_cast<std::size_t>(n) * n));
+        for (unsigned int k = 0; k <= p; k++) {
+            for (unsigned int i = 0; i < n; i++) {
+                for (unsigned int j = 0; j < n; j++) {
+                    result[k][i * n + j] = E[i * m + k * n + j];
+                }
+            }
+        }
+        return result;
+    }
+
+    std::vector<double> phi(double z, unsigned int p) {
+        std::vector<double> result(p + 1);
+        if (std::abs(z) < 1.0) {
+            // phi_k(z) = sum_j z^j / (j + k)!
+            for (unsigned int k = 0; k <= p; k++) {
+                double term = 1.0;
+                for (unsigned int j = 1; j <= k; j++) {
+                    term /= j;
+                }
+                double sum = 0.0;
+                for (unsigned int j = 0; j < 30; j++) {
+                    sum += term;
+                    term *= z / (j + k + 1);
+                }
+                result[k] = sum;
+            }
+        } else {
+            result[0] = std::exp(z);
+            double factorial = 1.0;
+            for (unsigned int k = 0; k < p; k++) {
+                result[k + 1] = (result[k] - 1.0 / factorial) / z;
+                factorial *= k + 1;
+            }
+        }
+        return result;
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * @brief Functions of dense square matrices, stored row-major.
+ *
+ */
+namespace matrixFunctions {
+
+    /**
+     * @brief Computes C = A * B for n x n matrices.
+     */
+    std::vector<double> multiply(const std::vector<double>& A, const std::vector<double>& B, unsigned int n);
+
+    /**
+     * @brief Matrix exponential e^A by scaling and squaring with a [6/6] Pade approximant.
+     *
+     * @param A  n x n matrix
+     * @param n  Dimension of the matrix
+     * @return e^A
+     */
+    std::vector<double> exponential(const std::vector<double>& A, unsigned int n);
+
+    /**
+     * @brief Computes phi_0(Z) = e^Z, ..., phi_p(Z) with phi_{k+1}(Z) = Z^-1 (phi_k(Z) - I / k!).
+     *
+     * The functions are read off the exponential of the augmented block matrix [[Z, I, 0], [0, 0, I], [0, 0, 0]]
+     * (for p = 2), which avoids inverting Z and is accurate for singular or nearly singular Z.
+     *
+     * @param Z  n x n matrix
+     * @param n  Dimension of the matrix
+     * @param p  Highest phi function
+     * @return The matrices phi_0(Z), ..., phi_p(Z).
+     */
+    std::vector<std::vector<double>> phi(const std::vector<double>& Z, unsigned int n, unsigned int p);
+
+    /**
+     * @brief Computes phi_0(z), ..., phi_p(z) for a scalar z, using the Taylor series for small |z|.
+     */
+    std::vector<double> phi(double z, unsigned int p);
+}
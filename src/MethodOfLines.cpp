@@ -0,0 +1,187 @@
+#include "MethodOfLines.h"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+MethodOfLines::MethodOfLines(Grid grid, double diffusion, std::array<double, 2> velocity, ReactionFunction reaction,
+                             ReactionFunction reactionDerivative)
+        : grid(grid), diffusion(diffusion), velocity(velocity), reaction(std::move(reaction)),
+          reactionDerivative(std::move(reactionDerivative)) {
+    if (grid.nx == 0 || grid.ny == 0) {
+        throw std::invalid_argument("Grid needs at least one point in every direction");
+    }
+    bool periodic = grid.boundary == Boundary::Periodic;
+    dx = grid.lx / (periodic ? grid.nx : grid.nx + 1);
+    dy = grid.ly / (periodic ? grid.ny : grid.ny + 1);
+    if (grid.ny == 1) {
+        // 1D problem, no coupling in y
+        this->velocity[1] = 0.0;
+    }
+}
+
+std::array<double, 2> MethodOfLines::point(unsigned int k) const {
+    unsigned int i = k % grid.nx;
+    unsigned int j = k / grid.nx;
+    unsigned int offset = grid.boundary == Boundary::Periodic ? 0 : 1;
+    return {(i + offset) * dx, grid.ny == 1 ? 0.0 : (j + offset) * dy};
+}
+
+std::array<double, 5> MethodOfLines::weights(bool withDiffusion, bool withTransport) const {
+    std::array<double, 5> w{0.0, 0.0, 0.0, 0.0, 0.0};
+    if (withDiffusion) {
+        double cx = diffusion / (dx * dx);
+        double cy = grid.ny == 1 ? 0.0 : diffusion / (dy * dy);
+        w = {cx, cx, cy, cy, -2 * cx - 2 * cy};
+    }
+    if (withTransport) {
+        // Upwind differences
+        w[0] += std::max(velocity[0], 0.0) / dx;
+        w[1] += std::max(-velocity[0], 0.0) / dx;
+        w[2] += std::max(velocity[1], 0.0) / dy;
+        w[3] += std::max(-velocity[1], 0.0) / dy;
+        w[4] -= std::abs(velocity[0]) / dx + std::abs(velocity[1]) / dy;
+    }
+    return w;
+}
+
+void MethodOfLines::evaluate(const std::vector<double>& u, double t, std::vector<double>& dudt, bool withDiffusion,
+                             bool withTransport, std::vector<double>& r) const {
+    const unsigned int nx = grid.nx;
+    const unsigned int ny = grid.ny;
+    const bool periodic = grid.boundary == Boundary::Periodic;
+    const double g = grid.boundaryValue;
+    const auto [wW, wE, wS, wN, wC] = weights(withDiffusion, withTransport);
+    if (withTransport && reaction) {
+        reaction(u, t, r);
+    } else {
+        std::fill(r.begin(), r.end(), 0.0);
+    }
+    const std::vector<double> ghostRow(nx, g);
+    for (unsigned int j = 0; j < ny; j++) {
+        const double* row = &u[j * nx];
+        const double* south = j > 0 ? row - nx : (periodic ? &u[(ny - 1) * nx] : ghostRow.data());
+        const double* north = j + 1 < ny ? row + nx : (periodic ? &u[0] : ghostRow.data());
+        const double* source = &r[j * nx];
+        double* out = &dudt[j * nx];
+        auto edge = [&](unsigned int i, double west, double east) {
+            out[i] = wW * west + wE * east + wS * south[i] + wN * north[i] + wC * row[i] + source[i];
+        };
+        if (nx == 1) {
+            edge(0, periodic ? row[0] : g, periodic ? row[0] : g);
+            continue;
+        }
+        edge(0, periodic ? row[nx - 1] : g, row[1]);
+        for (unsigned int i = 1; i + 1 < nx; i++) {
+            out[i] = wW * row[i - 1] + wE * row[i + 1] + wS * south[i] + wN * north[i] + wC * row[i] + source[i];
+        }
+        edge(nx - 1, row[nx - 2], periodic ? row[0] : g);
+    }
+}
+
+SystemFunction MethodOfLines::part(bool withDiffusion, bool withTransport) const {
+    return [model = *this, withDiffusion, withTransport, r = std::vector<double>(size())](
+            const std::vector<double>& u, double t, std::vector<double>& dudt) mutable {
+        model.evaluate(u, t, dudt, withDiffusion, withTransport, r);
+    };
+}
+
+/**
+ * @brief Triplets of the stencil with the given weights of the west, east, south, north neighbours and the centre.
+ */
+static std::vector<Triplet> stencilTriplets(unsigned int nx, unsigned int ny, bool periodic,
+                                            const std::array<double, 5>& w) {
+    std::vector<Triplet> triplets;
+    triplets.reserve(5 * nx * ny);
+    for (unsigned int j = 0; j < ny; j++) {
+        for (unsigned int i = 0; i < nx; i++) {
+            unsigned int k = i + nx * j;
+            triplets.push_back({k, k, w[4]});
+            if (i > 0 || periodic) {
+                triplets.push_back({k, (i + nx - 1) % nx + nx * j, w[0]});
+            }
+            if (i + 1 < nx || periodic) {
+                triplets.push_back({k, (i + 1) % nx + nx * j, w[1]});
+            }
+            if (ny == 1) {
+                continue;
+            }
+            if (j > 0 || periodic) {
+                triplets.push_back({k, i + nx * ((j + ny - 1) % ny), w[2]});
+            }
+            if (j + 1 < ny || periodic) {
+                triplets.push_back({k, i + nx * ((j + 1) % ny), w[3]});
+            }
+        }
+    }
+    return triplets;
+}
+
+CSRMatrix MethodOfLines::jacobianPattern() const {
+    CSRMatrix pattern = CSRMatrix::fromTriplets(size(), size(), stencilTriplets(
+            grid.nx, grid.ny, grid.boundary == Boundary::Periodic, {1.0, 1.0, 1.0, 1.0, 1.0}));
+    std::fill(pattern.values.begin(), pattern.values.end(), 0.0);
+    return pattern;
+}
+
+SparseJacobianFunction MethodOfLines::jacobian(bool diffusionOnly) const {
+    // The linear part is fixed, only the reaction derivative on the diagonal changes
+    CSRMatrix linear = CSRMatrix::fromTriplets(size(), size(), stencilTriplets(
+            grid.nx, grid.ny, grid.boundary == Boundary::Periodic, weights(true, !diffusionOnly)));
+    std::vector<int> diagonal(size());
+    for (unsigned int k = 0; k < size(); k++) {
+        diagonal[k] = linear.find(k, k);
+    }
+    ReactionFunction derivative = diffusionOnly ? nullptr : reactionDerivative;
+    if (!diffusionOnly && reaction && !derivative) {
+        derivative = [reaction = reaction, r = std::vector<double>(), shifted = std::vector<double>(),
+                      rShifted = std::vector<double>()](const std::vector<double>& u, double t,
+                                                        std::vector<double>& dr) mutable {
+            r.resize(u.size());
+            rShifted.resize(u.size());
+            shifted = u;
+            const double eps = std::sqrt(std::numeric_limits<double>::epsilon());
+            for (unsigned int k = 0; k < u.size(); k++) {
+                shifted[k] += eps * (1 + std::abs(u[k]));
+            }
+            reaction(u, t, r);
+            reaction(shifted, t, rShifted);
+            for (unsigned int k = 0; k < u.size(); k++) {
+                dr[k] = (rShifted[k] - r[k]) / (shifted[k] - u[k]);
+            }
+        };
+    }
+    return [linear = std::move(linear), diagonal = std::move(diagonal), derivative = std::move(derivative),
+            dr = std::vector<double>(size())](const std::vector<double>& u, double t, CSRMatrix& J) mutable {
+        if (J.rows != linear.rows || J.values.size() != linear.values.size()) {
+            J = linear;
+        } else {
+            std::copy(linear.values.begin(), linear.values.end(), J.values.begin());
+        }
+        if (derivative) {
+            derivative(u, t, dr);
+            for (unsigned int k = 0; k < dr.size(); k++) {
+                J.values[diagonal[k]] += dr[k];
+            }
+        }
+    };
+}
+
+BandedJacobianFunction MethodOfLines::bandedJacobian(bool diffusionOnly) const {
+    if (!isBanded()) {
+        throw std::invalid_argument("The Jacobian of a periodic grid is not banded");
+    }
+    return [sparse = jacobian(diffusionOnly), J = CSRMatrix()](const std::vector<double>& u, double t,
+                                                              BandedMatrix& banded) mutable {
+        sparse(u, t, J);
+        for (unsigned int i = 0; i < J.rows; i++) {
+            for (unsigned int p = J.rowPtr[i]; p < J.rowPtr[i + 1]; p++) {
+                banded(i, J.colIdx[p]) = J.values[p];
+            }
+        }
+    };
+}
+
+std::pair<unsigned int, unsigned int> MethodOfLines::bandwidth() const {
+    unsigned int width = grid.ny == 1 ? std::min(1u, grid.nx - 1) : grid.nx;
+    return {width, width};
+}
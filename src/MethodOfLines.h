@@ -0,0 +1,144 @@
+#pragma once
+
+#include <array>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "ODESystemSolver.h"
+#include "SparseMatrix.h"
+#include "SparseNewtonMatrix.h"
+#include "BandedMatrix.h"
+
+/**
+ * @brief Method-of-lines front end for diffusion-advection-reaction equations on structured 1D and 2D grids,
+ *
+ *     u_t = D (u_xx + u_yy) - v_x u_x - v_y u_y + R(u, t, x, y),
+ *
+ * turning them into a system of ODEs for the values at the grid points, numbered x first (k = i + nx * j).
+ * Diffusion uses the second order central stencil and advection the first order upwind stencil. The right hand side
+ * is evaluated as one sweep over the grid rows with the reaction evaluated for the whole field at once, so there are
+ * no function calls per grid point. The Jacobian and its fixed pattern are exported for the implicit solvers, as is
+ * the split into the stiff diffusion and the remaining transport part for IMEX methods.
+ */
+class MethodOfLines {
+
+public:
+    enum class Boundary {
+        Dirichlet,  // u = boundaryValue outside the domain, the unknowns are the interior points
+        Periodic    // the grid wraps around in every direction
+    };
+
+    /**
+     * @brief Structured grid on [0, lx] x [0, ly].
+     *
+     * @param nx             Number of unknowns in x
+     * @param ny             Number of unknowns in y, 1 for a 1D problem
+     * @param lx             Length of the domain in x
+     * @param ly             Length of the domain in y, irrelevant for a 1D problem
+     * @param boundary       Boundary condition in all directions
+     * @param boundaryValue  Value of u on a Dirichlet boundary
+     */
+    struct Grid {
+        unsigned int nx;
+        unsigned int ny = 1;
+        double lx = 1.0;
+        double ly = 1.0;
+        Boundary boundary = Boundary::Dirichlet;
+        double boundaryValue = 0.0;
+    };
+
+    /**
+     * @brief Reaction term for the whole field, writes R(u_k, t, x_k, y_k) for all grid points k into r.
+     */
+    using ReactionFunction = std::function<void(const std::vector<double>& u, double t, std::vector<double>& r)>;
+
+    /**
+     * @brief Construct a MethodOfLines object
+     *
+     * @param               grid  The grid
+     * @param          diffusion  Diffusion coefficient D
+     * @param           velocity  Advection velocity (v_x, v_y)
+     * @param           reaction  Reaction term, none if empty
+     * @param reactionDerivative  dR/du for the whole field, approximated by a difference quotient if empty
+     */
+    MethodOfLines(Grid grid, double diffusion, std::array<double, 2> velocity = {0.0, 0.0},
+                  ReactionFunction reaction = nullptr, ReactionFunction reactionDerivative = nullptr);
+
+    /**
+     * @brief Number of unknowns.
+     */
+    unsigned int size() const { return grid.nx * grid.ny; }
+
+    /**
+     * @brief Coordinates of grid point k.
+     */
+    std::array<double, 2> point(unsigned int k) const;
+
+    /**
+     * @brief The full right hand side.
+     */
+    SystemFunction rhs() const { return part(true, true); }
+
+    /**
+     * @brief The diffusion part of the right hand side, stiff and linear.
+     */
+    SystemFunction diffusionPart() const { return part(true, false); }
+
+    /**
+     * @brief The advection and reaction part of the right hand side.
+     */
+    SystemFunction transportPart() const { return part(false, true); }
+
+    /**
+     * @brief Pattern of the Jacobian, the diagonal and the stencil neighbours of every point.
+     */
+    CSRMatrix jacobianPattern() const;
+
+    /**
+     * @brief Jacobian of the full right hand side, or of the diffusion part only, on jacobianPattern().
+     */
+    SparseJacobianFunction jacobian(bool diffusionOnly = false) const;
+
+    /**
+     * @brief Whether the Jacobian is banded, i.e. the grid has no wrap-around entries.
+     */
+    bool isBanded() const { return grid.boundary == Boundary::Dirichlet; }
+
+    /**
+     * @brief jacobian() in band storage with the bandwidths of bandwidth(), for Dirichlet grids only.
+     */
+    BandedJacobianFunction bandedJacobian(bool diffusionOnly = false) const;
+
+    /**
+     * @brief Lower and upper bandwidth of the Jacobian, the wrap-around entries of periodic grids excluded.
+     */
+    std::pair<unsigned int, unsigned int> bandwidth() const;
+
+    /**
+     * @brief Evaluates parts of the right hand side.
+     * @param u          Values at the grid points
+     * @param t          Time
+     * @param dudt       Output, of the size of u
+     * @param diffusion  Whether to include the diffusion
+     * @param transport  Whether to include advection and reaction
+     * @param r          Work space of the size of u
+     */
+    void evaluate(const std::vector<double>& u, double t, std::vector<double>& dudt, bool diffusion, bool transport,
+                  std::vector<double>& r) const;
+
+private:
+    Grid grid;
+    double diffusion;
+    std::array<double, 2> velocity;
+    ReactionFunction reaction;
+    ReactionFunction reactionDerivative;
+    double dx;
+    double dy;
+
+    SystemFunction part(bool withDiffusion, bool withTransport) const;
+
+    /**
+     * @brief Stencil weights of the west, east, south and north neighbours and of the centre.
+     */
+    std::array<double, 5> weights(bool withDiffusion, bool withTransport) const;
+};
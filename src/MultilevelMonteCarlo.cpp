@@ -0,0 +1,123 @@
+#include "MultilevelMonteCarlo.h"
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <stdexcept>
+
+MultilevelMonteCarlo::MultilevelMonteCarlo(SDESolver solver, std::function<double(double y)> payoff, double tEnd,
+                                           unsigned int baseSteps, std::shared_ptr<ThreadPool> pool,
+                                           std::uint64_t initialSamples, unsigned int maxLevels)
+        : solver(std::move(solver)), payoff(std::move(payoff)), tEnd(tEnd), baseSteps(baseSteps),
+          pool(std::move(pool)), initialSamples(initialSamples), maxLevels(maxLevels) {
+    if (baseSteps < 2 || baseSteps % 2 != 0) {
+        throw std::invalid_argument("Level 0 needs an even number of steps");
+    }
+    if (initialSamples < 2 || maxLevels < 3 || maxLevels > 24) {
+        throw std::invalid_argument("Multilevel Monte Carlo needs 3 to 24 levels and at least 2 initial samples");
+    }
+}
+
+void MultilevelMonteCarlo::Accumulator::add(double x) {
+    count++;
+    double delta = x - mean;
+    mean += delta / count;
+    m2 += delta * (x - mean);
+}
+
+void MultilevelMonteCarlo::Accumulator::merge(const Accumulator& other) {
+    if (other.count == 0) {
+        return;
+    }
+    double total = count + other.count;
+    double delta = other.mean - mean;
+    mean += delta * other.count / total;
+    m2 += other.m2 + delta * delta * count * other.count / total;
+    count += other.count;
+}
+
+MultilevelMonteCarlo::Accumulator MultilevelMonteCarlo::sample(unsigned int level, std::uint64_t first,
+                                                               std::uint64_t count) const {
+    Accumulator accumulator;
+    const unsigned int steps = baseSteps << level;
+    for (std::uint64_t i = first; i < first + count; i++) {
+        const std::uint64_t path = (static_cast<std::uint64_t>(level) << 40) | i;
+        std::array<double, 2> y = solver.coupledTerminalValues(tEnd, steps, path);
+        accumulator.add(level == 0 ? payoff(y[0]) : payoff(y[0]) - payoff(y[1]));
+    }
+    return accumulator;
+}
+
+MultilevelMonteCarlo::Result MultilevelMonteCarlo::estimate(double tol) {
+    const std::uint64_t chunkSize = 4096;
+    auto cost = [this](unsigned int level) {
+        double fine = static_cast<double>(baseSteps << level);
+        return level == 0 ? fine : 1.5 * fine;
+    };
+    auto variance = [](const Accumulator& a) { return a.m2 / (a.count - 1); };
+    std::vector<Accumulator> levels(3);
+    std::vector<std::uint64_t> extra(3, initialSamples);
+    double bias = 0.0;
+    while (true) {
+        // New samples of all levels, chunks merged in order so that the result does not depend on the threads
+        std::vector<std::pair<unsigned int, std::future<Accumulator>>> pending;
+        std::vector<std::pair<unsigned int, Accumulator>> done;
+        for (unsigned int l = 0; l < levels.size(); l++) {
+            for (std::uint64_t first = levels[l].count; first < levels[l].count + extra[l]; first += chunkSize) {
+                std::uint64_t count = std::min(chunkSize, levels[l].count + extra[l] - first);
+                if (pool) {
+                    pending.emplace_back(l, pool->submit([this, l, first, count]() {
+                        return sample(l, first, count);
+                    }));
+                } else {
+                    done.emplace_back(l, sample(l, first, count));
+                }
+            }
+        }
+        for (auto& [l, task]: pending) {
+            done.emplace_back(l, task.get());
+        }
+        for (auto& [l, accumulator]: done) {
+            levels[l].merge(accumulator);
+        }
+        std::fill(extra.begin(), extra.end(), 0);
+
+        // Optimal numbers of samples for the sampling variance tol^2 / 2
+        double sum = 0.0;
+        for (unsigned int l = 0; l < levels.size(); l++) {
+            sum += std::sqrt(variance(levels[l]) * cost(l));
+        }
+        bool moreSamples = false;
+        for (unsigned int l = 0; l < levels.size(); l++) {
+            double optimal = std::ceil(2 / (tol * tol) * std::sqrt(variance(levels[l]) / cost(l)) * sum);
+            if (optimal > levels[l].count) {
+                extra[l] = static_cast<std::uint64_t>(optimal) - levels[l].count;
+                moreSamples = true;
+            }
+        }
+        if (moreSamples) {
+            continue;
+        }
+        // Bias of the finest level, assuming weak order 1: E[P - P_L] ~ E[P_L - P_{L-1}]
+        const unsigned int L = levels.size() - 1;
+        bias = std::max(std::abs(levels[L].mean), std::abs(levels[L - 1].mean) / 2);
+        if (bias <= tol / std::sqrt(2.0) || levels.size() == maxLevels) {
+            break;
+        }
+        levels.emplace_back();
+        extra.push_back(initialSamples);
+    }
+
+    Result result;
+    double samplingVariance = 0.0;
+    for (unsigned int l = 0; l < levels.size(); l++) {
+        result.estimate += levels[l].mean;
+        samplingVariance += variance(levels[l]) / levels[l].count;
+        result.cost += levels[l].count * cost(l);
+        result.levels.push_back({levels[l].count, levels[l].mean, variance(levels[l]), cost(l)});
+    }
+    result.rmse = std::sqrt(samplingVariance + bias * bias);
+    // Plain Monte Carlo on the finest level, with Var[P_L] ~ Var[P_0], needs 2 Var[P_0] / tol^2 samples
+    const double finestSteps = static_cast<double>(baseSteps << (levels.size() - 1));
+    result.singleLevelCost = 2 * variance(levels[0]) / (tol * tol) * finestSteps;
+    return result;
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "SDESolver.h"
+#include "ThreadPool.h"
+
+/**
+ * @brief Multilevel Monte Carlo estimation of E[P(y(tEnd))] for the solution y of an SDE (Giles 2008).
+ *
+ * Level l uses baseSteps * 2^l steps. The expectation of the finest level is written as the telescoping sum of
+ * E[P_0] and the corrections E[P_l - P_{l-1}], whose samples are computed on a fine and a coarse path driven by the
+ * same Brownian path (SDESolver::coupledTerminalValues), so that their variance decays with l. The number of samples
+ * of every level follows from the online estimates of the variances and costs, minimizing the cost for the
+ * requested root mean square error, and levels are added until the estimated bias is small enough. The new samples
+ * of all levels of a round are computed in chunks on the ThreadPool if one is given. Sample i of level l is always
+ * path l * 2^40 + i of the SDESolver, so the estimate does not depend on the number of threads.
+ */
+class MultilevelMonteCarlo {
+
+public:
+    /**
+     * @brief Samples of one level.
+     *
+     * @param samples   Number of samples
+     * @param mean      Mean of P_l - P_{l-1} (of P_0 on level 0)
+     * @param variance  Variance of P_l - P_{l-1}
+     * @param cost      Number of SDE steps per sample
+     */
+    struct Level {
+        std::uint64_t samples = 0;
+        double mean = 0.0;
+        double variance = 0.0;
+        double cost = 0.0;
+    };
+
+    /**
+     * @brief Estimate and work.
+     *
+     * @param estimate         The estimate of E[P(y(tEnd))]
+     * @param rmse             Estimated root mean square error, sampling error and bias
+     * @param levels           The levels used
+     * @param cost             Total number of SDE steps
+     * @param singleLevelCost  Number of SDE steps of plain Monte Carlo on the finest level for the same error
+     */
+    struct Result {
+        double estimate = 0.0;
+        double rmse = 0.0;
+        std::vector<Level> levels;
+        double cost = 0.0;
+        double singleLevelCost = 0.0;
+
+        /**
+         * @brief The factor by which multilevel Monte Carlo is cheaper than plain Monte Carlo.
+         */
+        double savings() const { return singleLevelCost / cost; }
+    };
+
+    /**
+     * @brief Construct a MultilevelMonteCarlo object
+     *
+     * @param          solver  The SDE, its method is used on all levels
+     * @param          payoff  The function P of the solution at tEnd
+     * @param            tEnd  The time to solve the SDE to
+     * @param       baseSteps  Number of steps on level 0
+     * @param            pool  Optional thread pool
+     * @param  initialSamples  Number of samples of a new level
+     * @param       maxLevels  Maximum number of levels
+     */
+    MultilevelMonteCarlo(SDESolver solver, std::function<double(double y)> payoff, double tEnd,
+                         unsigned int baseSteps = 2, std::shared_ptr<ThreadPool> pool = nullptr,
+                         std::uint64_t initialSamples = 1000, unsigned int maxLevels = 16);
+
+    /**
+     * @brief Estimates E[P(y(tEnd))] with a root mean square error of about tol.
+     */
+    Result estimate(double tol);
+
+private:
+    SDESolver solver;
+    std::function<double(double y)> payoff;
+    double tEnd;
+    unsigned int baseSteps;
+    std::shared_ptr<ThreadPool> pool;
+    std::uint64_t initialSamples;
+    unsigned int maxLevels;
+
+    /**
+     * @brief Count, mean and sum of squared deviations of samples, merged with Chan's formula.
+     */
+    struct Accumulator {
+        std::uint64_t count = 0;
+        double mean = 0.0;
+        double m2 = 0.0;
+
+        void add(double x);
+
+        void merge(const Accumulator& other);
+    };
+
+    /**
+     * @brief Accumulates the samples first, ..., first + count - 1 of a level.
+     */
+    Accumulator sample(unsigned int level, std::uint64_t first, std::uint64_t count) const;
+};
@@ -0,0 +1,214 @@
+#include "MultipleShooting.h"
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include "DenseLU.h"
+
+MultipleShooting::MultipleShooting(SystemFunction f, DenseJacobianFunction jacobian, BoundaryFunction boundary,
+                                   ODESystemSolverFactory solver, unsigned int segments,
+                                   std::shared_ptr<ThreadPool> pool, double tol, unsigned int maxIterations)
+        : f(std::move(f)), jacobian(std::move(jacobian)), boundary(std::move(boundary)), solver(std::move(solver)),
+          segments(segments), pool(std::move(pool)), tol(tol), maxIterations(maxIterations) {
+    if (segments == 0) {
+        throw std::invalid_argument("Multiple shooting needs at least one segment");
+    }
+}
+
+MultipleShooting::Segment MultipleShooting::integrate(const std::vector<double>& s, double t, double stepSize,
+                                                      unsigned int steps) const {
+    const unsigned int n = s.size();
+    // z = (y, G) with G row-major. The segments run on the pool and a segment solver such as BulirschStoer may
+    // evaluate its sub-integrations on the pool as well, so y, f(y) and J(y) are scratch of the evaluating thread
+    SystemFunction variational = [this, n](const std::vector<double>& z, double tz, std::vector<double>& dz) {
+        thread_local std::vector<double> y, dy, J;
+        y.assign(z.begin(), z.begin() + n);
+        dy.resize(n);
+        J.assign(static_cast<std::size_t>(n) * n, 0.0);
+        f(y, tz, dy);
+        jacobian(y, tz, J);
+        std::copy(dy.begin(), dy.end(), dz.begin());
+        for (unsigned int i = 0; i < n; i++) {
+            for (unsigned int j = 0; j < n; j++) {
+                double sum = 0.0;
+                for (unsigned int k = 0; k < n; k++) {
+                    sum += J[i * n + k] * z[n + k * n + j];
+                }
+                dz[n + i * n + j] = sum;
+            }
+        }
+    };
+    std::vector<double> z0(n + n * n, 0.0);
+    std::copy(s.begin(), s.end(), z0.begin());
+    for (unsigned int i = 0; i < n; i++) {
+        z0[n + i * n + i] = 1.0;
+    }
+    std::vector<std::vector<double>> z = solver(variational, z0, t)->solve(stepSize, t + steps * stepSize);
+    if (z.size() < steps + 1) {
+        throw std::runtime_error("Segment solver stopped before the end of the segment");
+    }
+    z.resize(steps + 1);
+    Segment segment;
+    segment.trajectory.reserve(steps + 1);
+    for (const std::vector<double>& state: z) {
+        segment.trajectory.emplace_back(state.begin(), state.begin() + n);
+    }
+    segment.sensitivity.assign(z.back().begin() + n, z.back().end());
+    return segment;
+}
+
+std::vector<std::vector<double>>
+MultipleShooting::solve(const std::function<std::vector<double>(double t)>& guess, double a, double b,
+                        double stepSize) {
+    stats = Statistics();
+    unsigned int N = ceil((b - a) / stepSize) + 1;
+    const double h = (b - a) / (N - 1);
+    const unsigned int P = std::max(1u, std::min(segments, N - 1));
+    // Segment p covers the steps first[p] to first[p + 1]
+    std::vector<unsigned int> first(P + 1);
+    for (unsigned int p = 0; p <= P; p++) {
+        first[p] = p * (N - 1) / P;
+    }
+    std::vector<std::vector<double>> s(P);
+    for (unsigned int p = 0; p < P; p++) {
+        s[p] = guess(a + first[p] * h);
+    }
+    const unsigned int n = s[0].size();
+    const unsigned int m = n * P;
+
+    auto sweep = [&](const std::vector<std::vector<double>>& starts, std::vector<Segment>& result) {
+        result.resize(P);
+        auto task = [&](unsigned int p) {
+            result[p] = integrate(starts[p], a + first[p] * h, h, first[p + 1] - first[p]);
+        };
+        if (pool) {
+            std::vector<std::future<void>> pending;
+            for (unsigned int p = 0; p < P; p++) {
+                pending.push_back(pool->submit([&task, p]() { task(p); }));
+            }
+            for (std::future<void>& future: pending) {
+                future.get();
+            }
+        } else {
+            for (unsigned int p = 0; p < P; p++) {
+                task(p);
+            }
+        }
+        stats.integrations += P;
+    };
+    // Matching conditions of the segments followed by the boundary conditions, returns the maximum norm
+    std::vector<double> r(n);
+    auto residual = [&](const std::vector<std::vector<double>>& starts, const std::vector<Segment>& result,
+                        std::vector<double>& F) {
+        F.resize(m);
+        for (unsigned int p = 0; p + 1 < P; p++) {
+            for (unsigned int i = 0; i < n; i++) {
+                F[p * n + i] = result[p].trajectory.back()[i] - starts[p + 1][i];
+            }
+        }
+        boundary(starts[0], result[P - 1].trajectory.back(), r);
+        std::copy(r.begin(), r.end(), F.begin() + (P - 1) * n);
+        double norm = 0.0;
+        for (double value: F) {
+            norm = std::max(norm, std::abs(value));
+        }
+        return norm;
+    };
+
+    std::vector<Segment> current, trial;
+    std::vector<double> F, trialF;
+    sweep(s, current);
+    double norm = residual(s, current, F);
+    std::vector<double> matrix(static_cast<std::size_t>(m) * m);
+    std::vector<double> Ra(n * n), Rb(n * n), shifted(n), rShifted(n);
+    DenseLU lu;
+    while (true) {
+        if (stats.iterations == maxIterations) {
+            throw std::runtime_error("Multiple shooting did not converge");
+        }
+        stats.iterations++;
+        // Derivatives of the boundary conditions by forward differences
+        const std::vector<double>& yb = current[P - 1].trajectory.back();
+        boundary(s[0], yb, r);
+        for (unsigned int j = 0; j < n; j++) {
+            for (unsigned int side = 0; side < 2; side++) {
+                shifted = side == 0 ? s[0] : yb;
+                double delta = std::sqrt(std::numeric_limits<double>::epsilon()) * std::max(1.0, std::abs(shifted[j]));
+                shifted[j] += delta;
+                boundary(side == 0 ? shifted : s[0], side == 0 ? yb : shifted, rShifted);
+                std::vector<double>& R = side == 0 ? Ra : Rb;
+                for (unsigned int i = 0; i < n; i++) {
+                    R[i * n + j] = (rShifted[i] - r[i]) / delta;
+                }
+            }
+        }
+        std::fill(matrix.begin(), matrix.end(), 0.0);
+        for (unsigned int p = 0; p + 1 < P; p++) {
+            for (unsigned int i = 0; i < n; i++) {
+                double* row = matrix.data() + static_cast<std::size_t>(p * n + i) * m;
+                for (unsigned int j = 0; j < n; j++) {
+                    row[p * n + j] = current[p].sensitivity[i * n + j];
+                }
+                row[(p + 1) * n + i] = -1.0;
+            }
+        }
+        const std::vector<double>& G = current[P - 1].sensitivity;
+        for (unsigned int i = 0; i < n; i++) {
+            double* row = matrix.data() + static_cast<std::size_t>((P - 1) * n + i) * m;
+            for (unsigned int j = 0; j < n; j++) {
+                row[j] += Ra[i * n + j];
+                for (unsigned int k = 0; k < n; k++) {
+                    row[(P - 1) * n + j] += Rb[i * n + k] * G[k * n + j];
+                }
+            }
+        }
+        lu.factorize(matrix, m);
+        std::vector<double> delta = F;
+        lu.solve(delta);
+        double deltaNorm = 0.0;
+        double scale = 0.0;
+        for (unsigned int k = 0; k < m; k++) {
+            deltaNorm = std::max(deltaNorm, std::abs(delta[k]));
+            scale = std::max(scale, std::abs(s[k / n][k % n]));
+        }
+        const bool converged = deltaNorm <= tol * (1 + scale);
+        // Damped step, halved until the residual decreases, the last full step is always taken
+        std::vector<std::vector<double>> next(P);
+        double lambda = 1.0;
+        while (true) {
+            for (unsigned int p = 0; p < P; p++) {
+                next[p] = s[p];
+                for (unsigned int i = 0; i < n; i++) {
+                    next[p][i] -= lambda * delta[p * n + i];
+                }
+            }
+            sweep(next, trial);
+            double trialNorm = residual(next, trial, trialF);
+            if (converged || trialNorm < norm) {
+                norm = trialNorm;
+                break;
+            }
+            lambda /= 2;
+            if (lambda < 1.0 / 1024) {
+                throw std::runtime_error("Multiple shooting did not converge");
+            }
+        }
+        s.swap(next);
+        current.swap(trial);
+        F.swap(trialF);
+        if (converged) {
+            break;
+        }
+    }
+    stats.residual = norm;
+
+    std::vector<std::vector<double>> y;
+    y.reserve(N);
+    for (unsigned int p = 0; p < P; p++) {
+        std::vector<std::vector<double>>& trajectory = current[p].trajectory;
+        y.insert(y.end(), std::make_move_iterator(trajectory.begin()),
+                 std::make_move_iterator(trajectory.end() - (p + 1 < P ? 1 : 0)));
+    }
+    return y;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "ODESystemSolver.h"
+#include "DenseLinearSolver.h"
+#include "ThreadPool.h"
+
+/**
+ * @brief Boundary conditions r(y(a), y(b)) = 0 of a two point boundary value problem, writes the n residuals into r.
+ */
+using BoundaryFunction = std::function<void(const std::vector<double>& ya, const std::vector<double>& yb,
+                                            std::vector<double>& r)>;
+
+/**
+ * @brief Class for solving two point boundary value problems y' = f(y, t), r(y(a), y(b)) = 0 by multiple shooting.
+ *
+ * [a, b] is split into segments. The unknowns are the values s_p at the segment starts, every segment is integrated
+ * from s_p with the given IVP solver, together with the variational equation G' = df/dy G, G(t_p) = I, whose solution
+ * G_p is the derivative of the segment end value with respect to s_p. Newton solves the matching conditions
+ * y_p(t_{p+1}) = s_{p+1} and the boundary conditions, the Jacobian has the blocks G_p and -I and the derivatives of r,
+ * which are approximated by forward differences. The Newton steps are damped until the residual decreases. The
+ * segments are independent, so they are integrated concurrently on the ThreadPool. Short segments keep the growth of
+ * G_p bounded, which makes multiple shooting work for problems on which single shooting (one segment) fails.
+ */
+class MultipleShooting {
+
+public:
+    /**
+     * @brief Work done by the last solve.
+     *
+     * @param iterations    Number of Newton iterations
+     * @param integrations  Number of segment integrations
+     * @param residual      Maximum norm of the matching and boundary conditions at the solution
+     */
+    struct Statistics {
+        unsigned int iterations = 0;
+        unsigned long integrations = 0;
+        double residual = 0.0;
+    };
+
+    /**
+     * @brief Construct a MultipleShooting object
+     *
+     * @param             f  Such that y' = f(y, t)
+     * @param      jacobian  Such that jacobian(y, t) = df(y, t)/dy
+     * @param      boundary  The boundary conditions
+     * @param        solver  IVP solver for the segments, it integrates y and G as one system of size n + n^2
+     * @param      segments  Number of shooting segments
+     * @param          pool  Thread pool for the segments, they run serially without one
+     * @param           tol  Relative tolerance of the Newton update
+     * @param maxIterations  Maximum number of Newton iterations
+     */
+    MultipleShooting(SystemFunction f, DenseJacobianFunction jacobian, BoundaryFunction boundary,
+                     ODESystemSolverFactory solver, unsigned int segments, std::shared_ptr<ThreadPool> pool = nullptr,
+                     double tol = 1e-10, unsigned int maxIterations = 50);
+
+    /**
+     * @brief Solves the boundary value problem on [a, b].
+     * @param guess    Initial guess of the solution, evaluated at the segment starts
+     * @param a        Left end of the interval
+     * @param b        Right end of the interval
+     * @param stepSize The step size, rounded down so that the steps end at b
+     * @return A vector of the solution vector at each step.
+     */
+    std::vector<std::vector<double>> solve(const std::function<std::vector<double>(double t)>& guess, double a,
+                                           double b, double stepSize);
+
+    const Statistics& statistics() const { return stats; }
+
+private:
+    SystemFunction f;
+    DenseJacobianFunction jacobian;
+    BoundaryFunction boundary;
+    ODESystemSolverFactory solver;
+    unsigned int segments;
+    std::shared_ptr<ThreadPool> pool;
+    double tol;
+    unsigned int maxIterations;
+    Statistics stats;
+
+    /**
+     * @brief Solution of one segment.
+     *
+     * @param trajectory   y at every step of the segment
+     * @param sensitivity  Derivative of the end value with respect to the start value, row-major
+     */
+    struct Segment {
+        std::vector<std::vector<double>> trajectory;
+        std::vector<double> sensitivity;
+    };
+
+    /**
+     * @brief Integrates y and the variational equation from s at t over the given number of steps.
+     */
+    Segment integrate(const std::vector<double>& s, double t, double stepSize, unsigned int steps) const;
+};
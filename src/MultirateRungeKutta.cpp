@@ -0,0 +1,125 @@
+#include "MultirateRungeKutta.h"
+#include <cmath>
+#include <stdexcept>
+
+/**
+ * @brief The full right hand side assembled from the slow and fast parts.
+ */
+static SystemFunction combined(SystemFunction slow, SystemFunction fast, std::vector<unsigned int> slowComponents,
+                               std::vector<unsigned int> fastComponents) {
+    return [slow = std::move(slow), fast = std::move(fast), slowComponents = std::move(slowComponents),
+            fastComponents = std::move(fastComponents)](const std::vector<double>& y, double t,
+                                                        std::vector<double>& dydt) {
+        std::vector<double> dSlow(slowComponents.size()), dFast(fastComponents.size());
+        slow(y, t, dSlow);
+        fast(y, t, dFast);
+        for (unsigned int i = 0; i < slowComponents.size(); i++) {
+            dydt[slowComponents[i]] = dSlow[i];
+        }
+        for (unsigned int i = 0; i < fastComponents.size(); i++) {
+            dydt[fastComponents[i]] = dFast[i];
+        }
+    };
+}
+
+/**
+ * @brief Indices in [0, n) that are not in components.
+ */
+static std::vector<unsigned int> complement(const std::vector<unsigned int>& components, std::size_t n) {
+    std::vector<bool> contained(n, false);
+    for (unsigned int i: components) {
+        if (i >= n || contained[i]) {
+            throw std::invalid_argument("Fast components must be distinct indices of y0");
+        }
+        contained[i] = true;
+    }
+    std::vector<unsigned int> rest;
+    for (unsigned int i = 0; i < n; i++) {
+        if (!contained[i]) {
+            rest.push_back(i);
+        }
+    }
+    return rest;
+}
+
+MultirateRungeKutta::MultirateRungeKutta(SystemFunction slow, SystemFunction fast,
+                                         std::vector<unsigned int> fastComponents, std::vector<double> y0, double t0,
+                                         unsigned int microSteps)
+        : ODESystemSolver(nullptr, std::move(y0), t0), slow(std::move(slow)), fast(std::move(fast)),
+          slowComponents(complement(fastComponents, this->y0.size())), fastComponents(std::move(fastComponents)),
+          microSteps(microSteps) {
+    if (microSteps == 0 || microSteps % 2 != 0) {
+        throw std::invalid_argument("Number of micro steps must be positive and even");
+    }
+    f = combined(this->slow, this->fast, slowComponents, this->fastComponents);
+}
+
+std::vector<std::vector<double>> MultirateRungeKutta::solve(double stepSize, double tEnd) {
+    // Classical Runge-Kutta table, the last row holds the weights
+    const double A[5][4] = {{0, 0, 0, 0},
+                            {0.5, 0, 0, 0},
+                            {0, 0.5, 0, 0},
+                            {0, 0, 1, 0},
+                            {1.0 / 6, 1.0 / 3, 1.0 / 3, 1.0 / 6}};
+    const double c[5] = {0, 0.5, 0.5, 1, 1};
+    const double cMicro[4] = {0.0, 0.5, 0.5, 1.0};
+    double t = t0;
+    unsigned int N = ceil((tEnd - t0) / stepSize) + 1;
+    const unsigned int nSlow = slowComponents.size();
+    const unsigned int nFast = fastComponents.size();
+    const double h = stepSize / microSteps;
+    slowEvaluations = 0;
+    fastEvaluations = 0;
+    std::vector<std::vector<double>> y;
+    y.reserve(N);
+    y.push_back(y0);
+    std::vector<std::vector<double>> k(4, std::vector<double>(nSlow));
+    std::vector<std::vector<double>> l(4, std::vector<double>(nFast));
+    std::vector<double> force(nSlow), slowStart(nSlow), fastStart(nFast);
+    for (int n = 1; n < N; n++) {
+        std::vector<double> Y = y.back();
+        for (unsigned int i = 0; i < 4; i++) {
+            slow(Y, t + c[i] * stepSize, k[i]);
+            slowEvaluations++;
+            // Slow increment up to the next stage
+            for (unsigned int s = 0; s < nSlow; s++) {
+                force[s] = 0.0;
+                for (unsigned int j = 0; j <= i; j++) {
+                    force[s] += (A[i + 1][j] - A[i][j]) * k[j][s];
+                }
+                slowStart[s] = Y[slowComponents[s]];
+            }
+            unsigned int substeps = std::lround((c[i + 1] - c[i]) * microSteps);
+            double tau = t + c[i] * stepSize;
+            for (unsigned int m = 0; m < substeps; m++) {
+                for (unsigned int s = 0; s < nFast; s++) {
+                    fastStart[s] = Y[fastComponents[s]];
+                }
+                for (unsigned int stage = 0; stage < 4; stage++) {
+                    // The slow components move linearly by stepSize * force over the substeps
+                    double fraction = (m + cMicro[stage]) / substeps;
+                    for (unsigned int s = 0; s < nSlow; s++) {
+                        Y[slowComponents[s]] = slowStart[s] + fraction * stepSize * force[s];
+                    }
+                    for (unsigned int s = 0; s < nFast; s++) {
+                        Y[fastComponents[s]] = fastStart[s] + (stage == 0 ? 0.0 : cMicro[stage] * h * l[stage - 1][s]);
+                    }
+                    fast(Y, tau + (m + cMicro[stage]) * h, l[stage]);
+                    fastEvaluations++;
+                }
+                for (unsigned int s = 0; s < nFast; s++) {
+                    Y[fastComponents[s]] = fastStart[s] + h / 6 * (l[0][s] + 2 * l[1][s] + 2 * l[2][s] + l[3][s]);
+                }
+            }
+            for (unsigned int s = 0; s < nSlow; s++) {
+                Y[slowComponents[s]] = slowStart[s] + stepSize * force[s];
+            }
+        }
+        y.push_back(std::move(Y));
+        if (events && stopAtEvent(y, t0 + (n - 1) * stepSize, t0 + n * stepSize)) {
+            break;
+        }
+        t = t0 + n * stepSize;
+    }
+    return y;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cmath>
+#include <utility>
+#include <vector>
+#include "ODESystemSolver.h"
+
+/**
+ * @brief Class for solving systems with a few fast and many slow components with a multirate infinitesimal step
+ * (MIS) method of Knoth and Wolke, built on the classical Runge-Kutta method.
+ *
+ * The slow right hand side is evaluated once per stage of the macro step. Between two stages the fast components are
+ * sub-cycled with classical Runge-Kutta micro steps, while the slow components move linearly from one stage value to
+ * the next, i.e. the fast components see interpolated slow inputs. The work spent on the slow components drops by the
+ * number of micro steps compared to a single rate method with the micro step size.
+ */
+class MultirateRungeKutta : public ODESystemSolver {
+
+public:
+    /**
+     * @brief Construct a MultirateRungeKutta object
+     *
+     * @param          slow  Writes the derivatives of the slow components, ordered as in y, given the full y
+     * @param          fast  Writes the derivatives of the fast components, ordered as fastComponents, given the full y
+     * @param fastComponents Indices of the fast components in y
+     * @param            y0  Initial value of y
+     * @param            t0  Initial value of t
+     * @param     microSteps Number of fast micro steps per macro step, even
+     */
+    MultirateRungeKutta(SystemFunction slow, SystemFunction fast, std::vector<unsigned int> fastComponents,
+                        std::vector<double> y0, double t0, unsigned int microSteps);
+
+    /**
+     * @brief Solves the system of ODEs using the multirate method.
+     * @param stepSize The macro step size, the fast components use stepSize / microSteps.
+     * @param tEnd The time to solve the ODE to.
+     * @return A vector of the solution vector at each macro step.
+     */
+    std::vector<std::vector<double>> solve(double stepSize, double tEnd) override;
+
+    /**
+     * @brief Number of evaluations of the slow and of the fast right hand side in the last solve.
+     */
+    std::pair<unsigned long, unsigned long> evaluations() const { return {slowEvaluations, fastEvaluations}; }
+
+private:
+    SystemFunction slow;
+    SystemFunction fast;
+    std::vector<unsigned int> slowComponents;
+    std::vector<unsigned int> fastComponents;
+    unsigned int microSteps;
+    unsigned long slowEvaluations = 0;
+    unsigned long fastEvaluations = 0;
+};
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <memory>
 #include <utility>
 #include <vector>
 #include <functional>
+#include "EventDetector.h"
+#include "DenseOutput.h"
 
 /**
  * @brief Abstract interface for solving ODEs.
@@ -14,6 +17,7 @@ protected:
     std::function<double(double y, double t)> f;
     double y0;
     double t0;
+    std::shared_ptr<EventDetector> events;
 
 protected:
     /**
@@ -25,6 +29,27 @@ protected:
      */
     ODESolver(std::function<double(double y, double t)> f, double y0, double t0) : f(std::move(f)), y0(y0), t0(t0) {}
 
+    /**
+     * @brief Checks the last step, from y[end - 1] at tPrev to y[end] at tNext, for events.
+     *
+     * Called by the solvers after every step, the first step starts the detector. After a terminal event inside the
+     * step the value at tNext is removed, so the solution ends at the last step before the event.
+     * @return Whether a terminal event ends the solve.
+     */
+    bool stopAtEvent(std::vector<double>& y, double tPrev, double tNext) {
+        if (y.size() == 2) {
+            events->start({y[0]}, tPrev);
+        }
+        auto system = [this](const std::vector<double>& z, double t, std::vector<double>& dz) { dz[0] = f(z[0], t); };
+        if (!events->step(system, {y[y.size() - 2]}, tPrev, {y.back()}, tNext)) {
+            return false;
+        }
+        if (events->records().back().t < tNext) {
+            y.pop_back();
+        }
+        return true;
+    }
+
 public:
     /**
      * @brief Solves the ODE.
@@ -33,6 +58,40 @@ public:
      * @return A vector of the solution at each step.
      */
     virtual std::vector<double> solve(double stepSize, double tEnd) = 0;
+
+    /**
+     * @brief Solves the ODE and returns the solution as a continuous function of t, with y' = f(y, t) at the steps.
+     * @param stepSize The step size.
+     * @param tEnd The time to solve the ODE to.
+     * @param order Cubic Hermite interpolation, or quintic to keep the accuracy of higher order methods.
+     * @return The dense output, of dimension one.
+     */
+    virtual DenseOutput solveDense(double stepSize, double tEnd,
+                                   DenseOutput::Order order = DenseOutput::Order::Cubic) {
+        std::vector<double> y = solve(stepSize, tEnd);
+        std::vector<std::vector<double>> values(y.size()), derivatives(y.size());
+        for (unsigned int n = 0; n < y.size(); n++) {
+            values[n] = {y[n]};
+            derivatives[n] = {f(y[n], t0 + n * stepSize)};
+        }
+        return {t0, stepSize, std::move(values), std::move(derivatives), order};
+    }
+
+    /**
+     * @brief Detects the zero crossings of event functions g(y, t) during solve, with y of size one.
+     */
+    virtual void setEvents(std::vector<Event> events) {
+        this->events = std::make_shared<EventDetector>(std::move(events));
+    }
+
+    /**
+     * @brief The events located during the last solve, in time order.
+     */
+    virtual const std::vector<EventRecord>& eventLog() const {
+        static const std::vector<EventRecord> none;
+        return events ? events->records() : none;
+    }
+
     virtual ~ODESolver() {} ;
 };
 
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include <functional>
+#include "EventDetector.h"
+#include "DenseOutput.h"
+
+/**
+ * @brief Right hand side of a system of ODEs, writes f(y, t) into dydt, which has the size of y.
+ */
+using SystemFunction = std::function<void(const std::vector<double>& y, double t, std::vector<double>& dydt)>;
+
+/**
+ * @brief Abstract interface for solving systems of ODEs y' = f(y, t) with y in R^n.
+ *
+ */
+class ODESystemSolver {
+
+protected:
+    SystemFunction f;
+    std::vector<double> y0;
+    double t0;
+    std::shared_ptr<EventDetector> events;
+
+protected:
+    /**
+     * @brief Construct an object derived from ODESystemSolver.
+     *
+     * @param  f  Such that y' = f(y, t)
+     * @param y0  Initial value of y
+     * @param t0  Initial value of t
+     */
+    ODESystemSolver(SystemFunction f, std::vector<double> y0, double t0) : f(std::move(f)), y0(std::move(y0)), t0(t0) {}
+
+    /**
+     * @brief Checks the last step, from y[end - 1] at tPrev to y[end] at tNext, for events.
+     *
+     * Called by the solvers after every step, the first step starts the detector. After a terminal event inside the
+     * step the value at tNext is removed, so the solution ends at the last step before the event.
+     * @param rhs  y' = rhs(y, t) for the interpolant of the step, for solvers whose f is only a part of y'
+     * @return Whether a terminal event ends the solve.
+     */
+    bool stopAtEvent(std::vector<std::vector<double>>& y, double tPrev, double tNext, const SystemFunction& rhs) {
+        if (y.size() == 2) {
+            events->start(y[0], tPrev);
+        }
+        if (!events->step(rhs, y[y.size() - 2], tPrev, y.back(), tNext)) {
+            return false;
+        }
+        if (events->records().back().t < tNext) {
+            y.pop_back();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks the last step for events, with y' = f(y, t).
+     */
+    bool stopAtEvent(std::vector<std::vector<double>>& y, double tPrev, double tNext) {
+        return stopAtEvent(y, tPrev, tNext, f);
+    }
+
+public:
+    /**
+     * @brief Solves the system of ODEs.
+     * @param stepSize The step size.
+     * @param tEnd The time to solve the ODE to.
+     * @return A vector of the solution vector at each step.
+     */
+    virtual std::vector<std::vector<double>> solve(double stepSize, double tEnd) = 0;
+
+    /**
+     * @brief Solves the system and returns the solution as a continuous function of t.
+     *
+     * The derivatives at the steps are f(y, t), solvers without such an f use differences of the values.
+     * @param stepSize The step size.
+     * @param tEnd The time to solve the ODE to.
+     * @param order Cubic Hermite interpolation, or quintic to keep the accuracy of higher order methods.
+     * @return The dense output.
+     */
+    virtual DenseOutput solveDense(double stepSize, double tEnd,
+                                   DenseOutput::Order order = DenseOutput::Order::Cubic) {
+        if (!f) {
+            return DenseOutput::fromValues(t0, stepSize, solve(stepSize, tEnd), order);
+        }
+        return DenseOutput::fromFunction(f, t0, stepSize, solve(stepSize, tEnd), order);
+    }
+
+    /**
+     * @brief Detects the zero crossings of event functions g(y, t) during solve.
+     *
+     * Solvers that cannot locate events throw std::invalid_argument.
+     */
+    virtual void setEvents(std::vector<Event> events) {
+        this->events = std::make_shared<EventDetector>(std::move(events));
+    }
+
+    /**
+     * @brief The events located during the last solve, in time order.
+     */
+    virtual const std::vector<EventRecord>& eventLog() const {
+        static const std::vector<EventRecord> none;
+        return events ? events->records() : none;
+    }
+
+    virtual ~ODESystemSolver() {} ;
+};
+
+/**
+ * @brief Creates a solver for the system y' = f(y, t) with initial value y0 at t0.
+ */
+using ODESystemSolverFactory = std::function<std::unique_ptr<ODESystemSolver>(SystemFunction f,
+                                                                              std::vector<double> y0, double t0)>;
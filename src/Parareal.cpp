@@ -0,0 +1,98 @@
+#include "Parareal.h"
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+Parareal::Parareal(std::function<double(double y, double t)> f, double y0, double t0, unsigned int slices,
+                   std::shared_ptr<ThreadPool> pool, double coarseStepSize, ODESolverFactory coarse,
+                   ODESolverFactory fine, double tol)
+        : ODESolver(std::move(f), y0, t0), slices(slices), pool(std::move(pool)), coarseStepSize(coarseStepSize),
+          coarse(std::move(coarse)), fine(std::move(fine)), tol(tol) {
+    if (slices == 0) {
+        throw std::invalid_argument("Parareal needs at least one time slice");
+    }
+}
+
+double Parareal::propagateCoarse(double y, double t, double length) const {
+    // Coarse steps that divide the slice, the solution is read at the slice end
+    unsigned int steps = std::max(1.0, std::ceil(length / coarseStepSize - 1e-9));
+    return coarse(f, y, t)->solve(length / steps, t + length)[steps];
+}
+
+std::vector<double> Parareal::solve(double stepSize, double tEnd) {
+    auto start = std::chrono::steady_clock::now();
+    stats = Statistics();
+    unsigned int N = ceil((tEnd - t0) / stepSize) + 1;
+    const unsigned int P = std::max(1u, std::min(slices, N - 1));
+    // Slice p covers the fine steps first[p] to first[p + 1]
+    std::vector<unsigned int> first(P + 1);
+    for (unsigned int p = 0; p <= P; p++) {
+        first[p] = p * (N - 1) / P;
+    }
+    auto sliceStart = [&](unsigned int p) { return t0 + first[p] * stepSize; };
+    auto sliceLength = [&](unsigned int p) { return (first[p + 1] - first[p]) * stepSize; };
+
+    std::vector<double> U(P + 1);
+    std::vector<double> G(P);
+    U[0] = y0;
+    for (unsigned int p = 0; p < P; p++) {
+        G[p] = propagateCoarse(U[p], sliceStart(p), sliceLength(p));
+        U[p + 1] = G[p];
+    }
+    std::vector<std::vector<double>> trajectories(P);
+    std::vector<double> fineTimes(P);
+    auto sweep = [&](unsigned int p) {
+        auto sliceTimer = std::chrono::steady_clock::now();
+        unsigned int steps = first[p + 1] - first[p];
+        trajectories[p] = fine(f, U[p], sliceStart(p))->solve(stepSize, sliceStart(p) + sliceLength(p));
+        trajectories[p].resize(steps + 1);
+        fineTimes[p] = secondsSince(sliceTimer);
+    };
+    // Slices before done start from exact values and keep their fine trajectories
+    for (unsigned int done = 0; done < P; done++) {
+        if (pool) {
+            std::vector<std::future<void>> pending;
+            for (unsigned int p = done; p < P; p++) {
+                pending.push_back(pool->submit([&sweep, p]() { sweep(p); }));
+            }
+            for (std::future<void>& task: pending) {
+                task.get();
+            }
+        } else {
+            for (unsigned int p = done; p < P; p++) {
+                sweep(p);
+            }
+        }
+        // The first sweep covers every slice once, as a serial fine solve would, but on the pool
+        if (stats.iterations++ == 0) {
+            for (double time: fineTimes) {
+                stats.estimatedSerialTime += time;
+            }
+        }
+        double change = 0.0;
+        for (unsigned int p = done; p < P; p++) {
+            double coarseValue = propagateCoarse(U[p], sliceStart(p), sliceLength(p));
+            double corrected = coarseValue + trajectories[p].back() - G[p];
+            G[p] = coarseValue;
+            change = std::max(change, std::abs(corrected - U[p + 1]) / (1 + std::abs(corrected)));
+            U[p + 1] = corrected;
+        }
+        if (change <= tol) {
+            break;
+        }
+    }
+
+    std::vector<double> y;
+    y.reserve(N);
+    for (unsigned int p = 0; p < P; p++) {
+        y.insert(y.end(), trajectories[p].begin(), trajectories[p].end() - 1);
+    }
+    y.push_back(trajectories[P - 1].back());
+    stats.wallTime = secondsSince(start);
+    return y;
+}
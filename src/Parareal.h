@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "ODESolver.h"
+#include "ThreadPool.h"
+#include "ExplicitEuler.h"
+#include "RungeKutta.h"
+
+/**
+ * @brief Creates a solver for y' = f(y, t) with initial value y0 at t0.
+ */
+using ODESolverFactory = std::function<std::unique_ptr<ODESolver>(std::function<double(double y, double t)> f,
+                                                                  double y0, double t0)>;
+
+/**
+ * @brief Factory for any solver with the constructor Solver(f, y0, t0).
+ */
+template<class Solver>
+ODESolverFactory makeFactory() {
+    return [](std::function<double(double y, double t)> f, double y0, double t0) -> std::unique_ptr<ODESolver> {
+        return std::make_unique<Solver>(std::move(f), y0, t0);
+    };
+}
+
+/**
+ * @brief Class for solving ODEs in parallel in time with the Parareal algorithm of Lions, Maday and Turinici.
+ *
+ * [t0, tEnd] is split into time slices. A cheap coarse propagator predicts the values at the slice boundaries
+ * serially, the accurate fine propagator is run on all slices concurrently, and the boundary values are corrected
+ * with U_{p+1} = G(U_p) + F(U_p^old) - G(U_p^old) until they change by less than the tolerance. After k iterations
+ * the first k slices are exact, so the iteration ends after at most as many iterations as slices.
+ */
+class Parareal : public ODESolver {
+
+public:
+    /**
+     * @brief Work done by the last solve.
+     *
+     * @param iterations           Number of parallel fine sweeps
+     * @param estimatedSerialTime  Time of the first fine sweep summed over the slices in seconds, an estimate of a
+     *                             serial fine solve: with a pool the slices run concurrently and compete for cores
+     *                             and memory bandwidth, so the estimate tends to be too large
+     * @param wallTime             Time of the whole solve in seconds
+     */
+    struct Statistics {
+        unsigned int iterations = 0;
+        double estimatedSerialTime = 0.0;
+        double wallTime = 0.0;
+    };
+
+    /**
+     * @brief Construct a Parareal object
+     *
+     * @param              f  Such that y' = f(y, t)
+     * @param             y0  Initial value of y
+     * @param             t0  Initial value of t
+     * @param         slices  Number of time slices
+     * @param           pool  Thread pool for the fine sweeps, they run serially without one
+     * @param coarseStepSize  Step size of the coarse propagator
+     * @param         coarse  Coarse propagator
+     * @param           fine  Fine propagator, used with the step size given to solve
+     * @param            tol  Relative tolerance of the slice boundary values
+     */
+    Parareal(std::function<double(double y, double t)> f, double y0, double t0, unsigned int slices,
+             std::shared_ptr<ThreadPool> pool, double coarseStepSize,
+             ODESolverFactory coarse = makeFactory<ExplicitEuler>(), ODESolverFactory fine = makeFactory<RungeKutta>(),
+             double tol = 1e-10);
+
+    /**
+     * @brief Solves the ODE using the Parareal algorithm.
+     * @param stepSize The step size of the fine propagator.
+     * @param tEnd The time to solve the ODE to.
+     * @return A vector of the solution at each fine step.
+     */
+    std::vector<double> solve(double stepSize, double tEnd) override;
+
+    /**
+     * @brief Not supported, all time slices are solved at once and cannot stop at an event.
+     */
+    void setEvents(std::vector<Event>) override {
+        throw std::invalid_argument("Parareal does not support events");
+    }
+
+    const Statistics& statistics() const { return stats; }
+
+    /**
+     * @brief Estimated speedup of the last solve over a serial fine solve, based on estimatedSerialTime and thus
+     * rather optimistic. Time a serial fine solve separately for an exact figure.
+     */
+    double estimatedSpeedup() const {
+        return stats.wallTime > 0.0 ? stats.estimatedSerialTime / stats.wallTime : 0.0;
+    }
+
+private:
+    unsigned int slices;
+    std::shared_ptr<ThreadPool> pool;
+    double coarseStepSize;
+    ODESolverFactory coarse;
+    ODESolverFactory fine;
+    double tol;
+    Statistics stats;
+
+    /**
+     * @brief Applies the coarse propagator to y at t over length.
+     */
+    double propagateCoarse(double y, double t, double length) const;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @brief Counter-based random number generator Philox4x32-10 of Salmon et al. (2011).
+ *
+ * A random block is a pure function of the key and a 128 bit counter, so any number of the sequence can be generated
+ * directly, independently of the others and of the thread that asks for it. There is no state besides the key, and
+ * the rounds are plain 32 bit integer operations, so loops over many counters vectorize.
+ */
+class Philox {
+
+public:
+    using Block = std::array<std::uint32_t, 4>;
+
+    /**
+     * @brief Construct a Philox object
+     *
+     * @param seed  The key, different seeds give independent streams
+     */
+    explicit Philox(std::uint64_t seed = 0)
+            : key{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)} {}
+
+    /**
+     * @brief The random block of the counter (c0, c1, c2, c3).
+     */
+    Block operator()(Block counter) const {
+        std::uint32_t k0 = key[0];
+        std::uint32_t k1 = key[1];
+        for (unsigned int round = 0; round < 10; round++) {
+            std::uint64_t p0 = static_cast<std::uint64_t>(0xD2511F53u) * counter[0];
+            std::uint64_t p1 = static_cast<std::uint64_t>(0xCD9E8D57u) * counter[2];
+            counter = {static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ k0, static_cast<std::uint32_t>(p1),
+                       static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ k1, static_cast<std::uint32_t>(p0)};
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        return counter;
+    }
+
+    /**
+     * @brief Two independent standard normal numbers for (stream, index), by Box-Muller on the block of the counter
+     * (index, stream).
+     */
+    std::array<double, 2> normals(std::uint64_t stream, std::uint64_t index) const {
+        Block r = (*this)({static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32),
+                           static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)});
+        double radius = std::sqrt(-2.0 * std::log(uniform(r[0], r[1])));
+        double angle = 2.0 * M_PI * uniform(r[2], r[3]);
+        return {radius * std::cos(angle), radius * std::sin(angle)};
+    }
+
+    /**
+     * @brief Standard normal number index of stream, i.e. normals(stream, index / 2)[index % 2].
+     */
+    double normal(std::uint64_t stream, std::uint64_t index) const {
+        return normals(stream, index / 2)[index % 2];
+    }
+
+    /**
+     * @brief Uniform number in (0, 1) from the 53 upper bits of (hi, lo).
+     */
+    static double uniform(std::uint32_t hi, std::uint32_t lo) {
+        std::uint64_t bits = (static_cast<std::uint64_t>(hi) << 21) | (lo >> 11);
+        return (static_cast<double>(bits) + 0.5) * 0x1.0p-53;
+    }
+
+private:
+    std::array<std::uint32_t, 2> key;
+};
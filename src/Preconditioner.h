@@ -0,0 +1,26 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * @brief Abstract interface for preconditioners M of the Newton matrix I - gamma * J(y, t) in Krylov solves.
+ *
+ */
+class Preconditioner {
+
+public:
+    /**
+     * @brief Builds the preconditioner for I - gamma * J(y, t).
+     * @param y     Point at which the Jacobian is evaluated
+     * @param t     Time at which the Jacobian is evaluated
+     * @param gamma Scaling of the Jacobian
+     */
+    virtual void setup(const std::vector<double>& y, double t, double gamma) = 0;
+
+    /**
+     * @brief Overwrites v with M^-1 * v.
+     */
+    virtual void apply(std::vector<double>& v) = 0;
+
+    virtual ~Preconditioner() {} ;
+};
@@ -0,0 +1,125 @@
+#include "RIDC.h"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+RIDC::RIDC(std::function<double(double y, double t)> f, double y0, double t0, unsigned int order, Variant variant,
+           std::function<double(double y, double t)> df)
+        : ImplicitSolver(std::move(f), y0, t0, std::move(df)), order(order), variant(variant) {
+    if (order == 0) {
+        throw std::invalid_argument("RIDC order must be positive");
+    }
+    if (variant == Variant::Implicit && !this->df) {
+        throw std::invalid_argument("Implicit RIDC needs df");
+    }
+}
+
+std::vector<std::vector<double>> RIDC::integrationWeights(unsigned int M) {
+    std::vector<std::vector<double>> weights(M, std::vector<double>(M + 1));
+    for (unsigned int i = 0; i <= M; i++) {
+        // Coefficients of L_i(x) = prod_{m != i} (x - m) / (i - m), lowest degree first
+        std::vector<double> L{1.0};
+        for (unsigned int m = 0; m <= M; m++) {
+            if (m == i) {
+                continue;
+            }
+            std::vector<double> product(L.size() + 1, 0.0);
+            for (unsigned int d = 0; d < L.size(); d++) {
+                product[d + 1] += L[d] / (static_cast<double>(i) - m);
+                product[d] -= L[d] * m / (static_cast<double>(i) - m);
+            }
+            L = std::move(product);
+        }
+        for (unsigned int j = 0; j < M; j++) {
+            double integral = 0.0;
+            for (unsigned int d = 0; d < L.size(); d++) {
+                integral += L[d] * (std::pow(j + 1.0, d + 1) - std::pow(j, d + 1)) / (d + 1);
+            }
+            weights[j][i] = integral;
+        }
+    }
+    return weights;
+}
+
+std::vector<double> RIDC::solve(double stepSize, double tEnd) {
+    unsigned int N = ceil((tEnd - t0) / stepSize) + 1;
+    // Quadrature on M + 1 equidistant nodes is exact enough for order M + 1
+    const unsigned int M = std::min(order - 1, N - 1);
+    const std::vector<std::vector<double>> weights = integrationWeights(M);
+    std::vector<std::vector<double>> eta(order, std::vector<double>(N));
+    std::vector<std::vector<double>> F(order, std::vector<double>(N));
+    // Number of values computed by each level, level l waits for level l - 1
+    std::vector<std::atomic<unsigned int>> done(order);
+    std::vector<unsigned int> valid(order, N);
+    std::atomic<bool> failed = false;
+
+    auto level = [&](unsigned int l) {
+        eta[l][0] = y0;
+        F[l][0] = f(y0, t0);
+        done[l].store(1);
+        done[l].notify_all();
+        for (unsigned int n = 0; n + 1 < N; n++) {
+            double tNext = t0 + (n + 1) * stepSize;
+            double value;
+            bool converged = true;
+            if (l == 0) {
+                if (variant == Variant::Explicit) {
+                    value = eta[0][n] + stepSize * F[0][n];
+                } else {
+                    std::tie(value, converged) = implicitEulerStep(eta[0][n], tNext, stepSize, eta[0][n]);
+                }
+            } else {
+                // Stencil [s, s + M] around the step, it needs the previous level up to s + M
+                unsigned int s = std::min(n + 1 > M ? n + 1 - M : 0, N - 1 - M);
+                unsigned int seen;
+                while ((seen = done[l - 1].load()) < s + M + 1 && !failed) {
+                    done[l - 1].wait(seen);
+                }
+                if (failed) {
+                    valid[l] = n + 1;
+                    break;
+                }
+                double integral = 0.0;
+                for (unsigned int i = 0; i <= M; i++) {
+                    integral += weights[n - s][i] * F[l - 1][s + i];
+                }
+                integral *= stepSize;
+                if (variant == Variant::Explicit) {
+                    value = eta[l][n] + stepSize * (F[l][n] - F[l - 1][n]) + integral;
+                } else {
+                    double base = eta[l][n] - stepSize * F[l - 1][n + 1] + integral;
+                    std::tie(value, converged) = implicitEulerStep(base, tNext, stepSize, eta[l - 1][n + 1]);
+                }
+            }
+            if (!converged) {
+                valid[l] = n + 1;
+                failed = true;
+                // Release the waiting levels, a changed count ends their wait
+                for (std::atomic<unsigned int>& count: done) {
+                    count.fetch_add(N);
+                    count.notify_all();
+                }
+                break;
+            }
+            eta[l][n + 1] = value;
+            F[l][n + 1] = f(value, tNext);
+            done[l].store(n + 2);
+            done[l].notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int l = 0; l < order; l++) {
+        threads.emplace_back(level, l);
+    }
+    for (std::thread& thread: threads) {
+        thread.join();
+    }
+    if (failed) {
+        std::cout << "Newton-Raphson method did not converge" << std::endl;
+    }
+    std::vector<double> y = std::move(eta[order - 1]);
+    y.resize(valid[order - 1]);
+    return y;
+}
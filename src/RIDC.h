@@ -0,0 +1,65 @@
+#pragma once
+
+#include "ImplicitSolver.h"
+#include <utility>
+#include <vector>
+#include <functional>
+#include <stdexcept>
+#include <iostream>
+#include <cmath>
+
+/**
+ * @brief Class for solving ODEs with revisionist integral deferred correction (RIDC) of Christlieb, Ong and Qiu.
+ *
+ * A first order Euler predictor is followed by order - 1 correction levels, each raising the order by one. Every
+ * level runs on its own thread and only lags the previous level by the width of the quadrature stencil, so order p
+ * is reached in about the wall-clock time of a single Euler sweep given p cores. The predictor and the corrections
+ * are explicit or implicit Euler steps. Since the levels call f (and df) from their threads at the same time, f and df
+ * must be safe to call concurrently.
+ */
+class RIDC : public ImplicitSolver {
+
+public:
+    enum class Variant {
+        Explicit,  // explicit Euler predictor and corrections
+        Implicit   // implicit Euler predictor and corrections, needs df
+    };
+
+    /**
+     * @brief Construct a RIDC object
+     *
+     * @param       f  Such that y' = f(y, t)
+     * @param      y0  Initial value of y
+     * @param      t0  Initial value of t
+     * @param   order  Order of accuracy, i.e. number of levels including the predictor
+     * @param variant  Explicit or implicit Euler steps
+     * @param      df  Such that df(y, t)/ dy = df(y, t), only used by the implicit variant
+     */
+    RIDC(std::function<double(double y, double t)> f, double y0, double t0, unsigned int order,
+         Variant variant = Variant::Explicit, std::function<double(double y, double t)> df = nullptr);
+
+    /**
+     * @brief Solves the ODE using RIDC.
+     * @param stepSize The step size.
+     * @param tEnd The time to solve the ODE to.
+     * @return A vector of the solution at each step.
+     */
+    std::vector<double> solve(double stepSize, double tEnd) override;
+
+    /**
+     * @brief Not supported, all correctors run over the whole interval and cannot stop at an event.
+     */
+    void setEvents(std::vector<Event>) override {
+        throw std::invalid_argument("RIDC does not support events");
+    }
+
+private:
+    unsigned int order;
+    Variant variant;
+
+    /**
+     * @brief Integrals over [j, j + 1] of the Lagrange basis polynomials on the nodes 0, ..., M.
+     * @return weights[j][i] for j < M and i <= M
+     */
+    static std::vector<std::vector<double>> integrationWeights(unsigned int M);
+};
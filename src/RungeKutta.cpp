@@ -12,6 +12,9 @@ std::vector<double> RungeKutta::solve(double stepSize, double tEnd) {
         double k3 = f(y.back() + stepSize * k2 / 2, t + stepSize / 2);
         double k4 = f(y.back() + stepSize * k3, t + stepSize);
         y.emplace_back(y.back() + stepSize * (k1 + 2 * k2 + 2 * k3 + k4) / 6);
+        if (events && stopAtEvent(y, t0 + (n - 1) * stepSize, t0 + n * stepSize)) {
+            break;
+        }
         t = t0 + n * stepSize;
     }
     return y;
@@ -0,0 +1,89 @@
+#include "RungeKuttaNystrom.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+void RungeKuttaNystrom::step(const std::vector<double>& q, const std::vector<double>& v, double t, double h) {
+    const unsigned int n = q.size();
+    for (unsigned int i = 0; i < n; i++) {
+        stage[i] = q[i] + h / 2 * v[i] + h * h / 8 * k1[i];
+    }
+    a(stage, t + h / 2, k2);
+    for (unsigned int i = 0; i < n; i++) {
+        stage[i] = q[i] + h * v[i] + h * h / 2 * k2[i];
+    }
+    a(stage, t + h, k3);
+    stats.evaluations += 2;
+    for (unsigned int i = 0; i < n; i++) {
+        qNew[i] = q[i] + h * v[i] + h * h * (k1[i] / 6 + k2[i] / 3);
+        vNew[i] = v[i] + h * (k1[i] / 6 + 2 * k2[i] / 3 + k3[i] / 6);
+    }
+}
+
+void RungeKuttaNystrom::advance(std::vector<double>& q, std::vector<double>& v, double t, double stepSize,
+                                unsigned long steps) {
+    const unsigned int n = q.size();
+    for (std::vector<double>* work: {&k1, &k2, &k3, &k4, &stage, &qNew, &vNew}) {
+        work->resize(n);
+    }
+    // The acceleration at the end of the previous call is reused when continuing from its final state
+    if (q != cachedQ || std::abs(t - cachedT) > 1e-12 * (1 + std::abs(t))) {
+        a(q, t, k1);
+        stats.evaluations++;
+    }
+    if (method == Method::RKN4) {
+        for (unsigned long s = 0; s < steps; s++) {
+            double tStep = t + s * stepSize;
+            step(q, v, tStep, stepSize);
+            q.swap(qNew);
+            v.swap(vNew);
+            a(q, tStep + stepSize, k1);
+            stats.evaluations++;
+            stats.acceptedSteps++;
+        }
+    } else {
+        if (H <= 0.0) {
+            H = stepSize;
+        }
+        double tc = t;
+        for (unsigned long s = 1; s <= steps; s++) {
+            const double tGrid = t + s * stepSize;
+            while (tGrid - tc > 1e-12 * std::max(1.0, std::abs(tGrid))) {
+                const double h = std::min(H, tGrid - tc);
+                if (h < 1e-14 * std::max(1.0, std::abs(tc))) {
+                    throw std::runtime_error("RKN step size too small");
+                }
+                const bool landsOnGrid = tGrid - (tc + h) <= 1e-12 * std::max(1.0, std::abs(tGrid));
+                const double tNew = landsOnGrid ? tGrid : tc + h;
+                step(q, v, tc, h);
+                a(qNew, tNew, k4);
+                stats.evaluations++;
+                // Differences to the embedded solution with weights (1/3, 0, 1/6, 0) and (1/6, 2/3, 0, 1/6)
+                double sum = 0.0;
+                for (unsigned int i = 0; i < n; i++) {
+                    double eq = h * h * (-k1[i] / 6 + k2[i] / 3 - k3[i] / 6);
+                    double ev = h * (k3[i] - k4[i]) / 6;
+                    double sq = tol + tol * std::max(std::abs(q[i]), std::abs(qNew[i]));
+                    double sv = tol + tol * std::max(std::abs(v[i]), std::abs(vNew[i]));
+                    sum += (eq / sq) * (eq / sq) + (ev / sv) * (ev / sv);
+                }
+                double error = std::sqrt(sum / (2 * n));
+                double factor = error == 0.0 ? 5.0 : std::clamp(0.9 * std::pow(error, -0.25), 0.2, 5.0);
+                if (error > 1.0) {
+                    stats.rejectedSteps++;
+                    H = h * factor;
+                    continue;
+                }
+                // A step clipped at a grid point says little about the step size
+                H = h < H ? std::max(H, h * factor) : h * factor;
+                stats.acceptedSteps++;
+                tc = tNew;
+                q.swap(qNew);
+                v.swap(vNew);
+                k1.swap(k4);
+            }
+        }
+    }
+    cachedQ = q;
+    cachedT = t + steps * stepSize;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+#include "SecondOrderSolver.h"
+
+/**
+ * @brief Class for solving second order systems q'' = a(q, t) with explicit Runge-Kutta-Nystroem methods.
+ *
+ * The stages only evaluate the acceleration, the velocities enter the stage positions directly, so no stages are
+ * spent on the trivial update q' = v as with a Runge-Kutta method for the doubled system. RKN4 is the classical
+ * three stage method of order 4 (c = 0, 1/2, 1), i.e. three evaluations per step instead of four for RungeKutta.
+ * RKN43 embeds a third order solution using the acceleration at the new positions, which is the first stage of the
+ * next step (first same as last), and adapts the internal step size to the tolerance, so it needs three evaluations
+ * per accepted step as well. The internal steps are clipped at the grid points t0 + n * stepSize.
+ */
+class RungeKuttaNystrom : public SecondOrderSolver {
+
+public:
+    enum class Method {
+        RKN4,   // fixed step size, order 4
+        RKN43   // adaptive step size, order 4 with an embedded order 3 error estimate
+    };
+
+    /**
+     * @brief Work done by the solver.
+     *
+     * @param acceptedSteps  Number of accepted internal steps
+     * @param rejectedSteps  Number of rejected internal steps
+     * @param evaluations    Number of evaluations of a
+     */
+    struct Statistics {
+        unsigned long acceptedSteps = 0;
+        unsigned long rejectedSteps = 0;
+        unsigned long evaluations = 0;
+    };
+
+    /**
+     * @brief Construct a RungeKuttaNystrom object
+     *
+     * @param      a  Such that q'' = a(q, t)
+     * @param     q0  Initial positions
+     * @param     v0  Initial velocities
+     * @param     t0  Initial value of t
+     * @param method  The method
+     * @param    tol  Absolute and relative tolerance of the local error of RKN43
+     */
+    RungeKuttaNystrom(AccelerationFunction a, std::vector<double> q0, std::vector<double> v0, double t0,
+                      Method method = Method::RKN4, double tol = 1e-8)
+            : SecondOrderSolver(std::move(a), std::move(q0), std::move(v0), t0), method(method), tol(tol) {}
+
+    void advance(std::vector<double>& q, std::vector<double>& v, double t, double stepSize,
+                 unsigned long steps) override;
+
+    const Statistics& statistics() const { return stats; }
+
+private:
+    Method method;
+    double tol;
+    Statistics stats;
+    // Stage accelerations and positions, k1 holds a(q, t) at the start of a step
+    std::vector<double> k1, k2, k3, k4, stage, qNew, vNew;
+    std::vector<double> cachedQ;
+    double cachedT = NAN;
+    // Proposed internal step size of RKN43
+    double H = 0.0;
+
+    /**
+     * @brief One RKN4 step from (q, v, t) with k1 = a(q, t) into qNew and vNew.
+     */
+    void step(const std::vector<double>& q, const std::vector<double>& v, double t, double h);
+};
@@ -0,0 +1,146 @@
+#include "SDESolver.h"
+#include <algorithm>
+#include <future>
+#include <stdexcept>
+
+SDESolver::SDESolver(std::function<double(double y, double t)> f, std::function<double(double y, double t)> g,
+                     double y0, double t0, Method method, std::uint64_t seed,
+                     std::function<double(double y, double t)> dg, double tol, unsigned int maxRefinements)
+        : ODESolver(std::move(f), y0, t0), g(std::move(g)), dg(std::move(dg)), method(method), rng(seed), tol(tol),
+          maxRefinements(maxRefinements) {
+    if (method == Method::Milstein && !this->dg) {
+        throw std::invalid_argument("Milstein method needs dg/dy");
+    }
+    if (maxRefinements > 15) {
+        throw std::invalid_argument("At most 15 refinements of a step are supported");
+    }
+}
+
+double SDESolver::step(double y, double t, double h, double dW) const {
+    if (method == Method::Milstein) {
+        double gy = g(y, t);
+        return y + f(y, t) * h + gy * dW + 0.5 * gy * dg(y, t) * (dW * dW - h);
+    }
+    if (method == Method::AdaptiveSRK) {
+        return srkStep(y, t, h, dW);
+    }
+    return y + f(y, t) * h + g(y, t) * dW;
+}
+
+double SDESolver::srkStep(double y, double t, double h, double dW) const {
+    const double fy = f(y, t);
+    const double gy = g(y, t);
+    const double sqrtH = std::sqrt(h);
+    // The difference of g at the supporting value replaces g g' of the Milstein term
+    const double support = y + fy * h + gy * sqrtH;
+    return y + fy * h + gy * dW + (g(support, t) - gy) * (dW * dW - h) / (2 * sqrtH);
+}
+
+double SDESolver::adaptiveStep(double y, double t, double h, double dW, std::uint64_t p, unsigned int level,
+                               std::uint64_t node) const {
+    double coarse = srkStep(y, t, h, dW);
+    if (level >= maxRefinements) {
+        return coarse;
+    }
+    // Brownian bridge: the first half of the increment given the whole, from a counter out of the range of the
+    // base increments
+    const std::uint64_t index = (std::uint64_t(1) << 63) | (static_cast<std::uint64_t>(level) << 48) | node;
+    const double dW1 = dW / 2 + std::sqrt(h) / 2 * rng.normal(p, index);
+    const double dW2 = dW - dW1;
+    double fine = srkStep(srkStep(y, t, h / 2, dW1), t + h / 2, h / 2, dW2);
+    if (std::abs(fine - coarse) <= tol * (1 + std::abs(fine))) {
+        return fine;
+    }
+    double middle = adaptiveStep(y, t, h / 2, dW1, p, level + 1, 2 * node);
+    return adaptiveStep(middle, t + h / 2, h / 2, dW2, p, level + 1, 2 * node + 1);
+}
+
+std::vector<double> SDESolver::path(double stepSize, double tEnd, std::uint64_t index) const {
+    double t = t0;
+    unsigned int N = ceil((tEnd - t0) / stepSize) + 1;
+    std::vector<double> y;
+    y.reserve(N);
+    y.push_back(y0);
+    for (int n = 1; n < N; n++) {
+        double dW = increment(index, n - 1, stepSize);
+        if (method == Method::AdaptiveSRK) {
+            y.push_back(adaptiveStep(y.back(), t, stepSize, dW, index, 0, n - 1));
+        } else {
+            y.push_back(step(y.back(), t, stepSize, dW));
+        }
+        t = t0 + n * stepSize;
+    }
+    return y;
+}
+
+std::array<double, 2> SDESolver::coupledTerminalValues(double tEnd, unsigned int fineSteps, std::uint64_t p) const {
+    if (fineSteps < 2 || fineSteps % 2 != 0) {
+        throw std::invalid_argument("Coupled paths need an even number of fine steps");
+    }
+    const double h = (tEnd - t0) / fineSteps;
+    double fine = y0;
+    double coarse = y0;
+    for (unsigned int k = 0; k < fineSteps; k += 2) {
+        std::array<double, 2> z = rng.normals(p, k / 2);
+        const double t = t0 + k * h;
+        double dW1 = std::sqrt(h) * z[0];
+        double dW2 = std::sqrt(h) * z[1];
+        fine = step(fine, t, h, dW1);
+        fine = step(fine, t + h, h, dW2);
+        coarse = step(coarse, t, 2 * h, dW1 + dW2);
+    }
+    return {fine, coarse};
+}
+
+void SDESolver::advanceLanes(std::uint64_t first, unsigned int count, unsigned int N, double stepSize,
+                             double* y) const {
+    const double sqrtH = std::sqrt(stepSize);
+    double z[2][lanes];
+    for (unsigned int k = 0; k + 1 < N; k++) {
+        // One Philox block gives the normals of two steps
+        if (k % 2 == 0) {
+            for (unsigned int l = 0; l < count; l++) {
+                std::array<double, 2> pair = rng.normals(first + l, k / 2);
+                z[0][l] = pair[0];
+                z[1][l] = pair[1];
+            }
+        }
+        const double t = t0 + k * stepSize;
+        for (unsigned int l = 0; l < count; l++) {
+            double dW = sqrtH * z[k % 2][l];
+            if (method == Method::AdaptiveSRK) {
+                y[l] = adaptiveStep(y[l], t, stepSize, dW, first + l, 0, k);
+            } else {
+                y[l] = step(y[l], t, stepSize, dW);
+            }
+        }
+    }
+}
+
+std::vector<double> SDESolver::terminalValues(double stepSize, double tEnd, std::uint64_t paths,
+                                              const std::shared_ptr<ThreadPool>& pool) const {
+    unsigned int N = ceil((tEnd - t0) / stepSize) + 1;
+    std::vector<double> y(paths, y0);
+    const std::uint64_t chunkSize = 512 * lanes;
+    auto chunk = [&, N, stepSize](std::uint64_t begin) {
+        std::uint64_t end = std::min(paths, begin + chunkSize);
+        for (std::uint64_t first = begin; first < end; first += lanes) {
+            unsigned int count = std::min<std::uint64_t>(lanes, end - first);
+            advanceLanes(first, count, N, stepSize, y.data() + first);
+        }
+    };
+    if (pool) {
+        std::vector<std::future<void>> pending;
+        for (std::uint64_t begin = 0; begin < paths; begin += chunkSize) {
+            pending.push_back(pool->submit([&chunk, begin]() { chunk(begin); }));
+        }
+        for (std::future<void>& task: pending) {
+            task.get();
+        }
+    } else {
+        for (std::uint64_t begin = 0; begin < paths; begin += chunkSize) {
+            chunk(begin);
+        }
+    }
+    return y;
+}
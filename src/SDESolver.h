@@ -0,0 +1,155 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "ODESolver.h"
+#include "Philox.h"
+#include "ThreadPool.h"
+
+/**
+ * @brief Class for solving scalar Ito stochastic differential equations dy = f(y, t) dt + g(y, t) dW.
+ *
+ * The drift f is the right hand side of ODESolver. The Brownian increment of step n of path p is
+ * sqrt(h) * Philox(seed).normal(p, n), so every path is reproducible on its own, whichever lane or thread computes
+ * it. The adaptive method refines a step by Brownian bridges whose normals are drawn from counters of the refinement
+ * level and position, so a refined path is still the same Brownian path.
+ *
+ * Many paths are simulated by terminalValues, in blocks of lanes paths advanced together (the random numbers of a
+ * block are generated in one loop over the lanes) and, given a ThreadPool, with chunks of blocks on the workers.
+ * f and g must then be safe to call concurrently.
+ */
+class SDESolver : public ODESolver {
+
+public:
+    enum class Method {
+        EulerMaruyama,  // strong order 1/2
+        Milstein,       // strong order 1, needs dg/dy
+        AdaptiveSRK     // derivative-free Runge-Kutta-Milstein of Platen with step doubling on the Brownian bridge
+    };
+
+    /**
+     * @brief Number of paths advanced together.
+     */
+    static constexpr unsigned int lanes = 8;
+
+    /**
+     * @brief Construct an SDESolver object
+     *
+     * @param             f  Drift, such that dy = f(y, t) dt + g(y, t) dW
+     * @param             g  Diffusion
+     * @param            y0  Initial value of y
+     * @param            t0  Initial value of t
+     * @param        method  The method
+     * @param          seed  Key of the random number generator
+     * @param            dg  Such that dg(y, t) = dg(y, t)/dy, required by Milstein
+     * @param           tol  Local error tolerance of AdaptiveSRK, absolute and relative
+     * @param maxRefinements Maximum number of halvings of a step of AdaptiveSRK, at most 15
+     */
+    SDESolver(std::function<double(double y, double t)> f, std::function<double(double y, double t)> g, double y0,
+              double t0, Method method = Method::EulerMaruyama, std::uint64_t seed = 0,
+              std::function<double(double y, double t)> dg = nullptr, double tol = 1e-4,
+              unsigned int maxRefinements = 10);
+
+    /**
+     * @brief Solves the SDE along path 0.
+     * @param stepSize The step size.
+     * @param tEnd The time to solve the SDE to.
+     * @return A vector of the solution at each step.
+     */
+    std::vector<double> solve(double stepSize, double tEnd) override { return path(stepSize, tEnd, 0); }
+
+    /**
+     * @brief Not supported, the paths are not differentiable and the drift alone does not interpolate them.
+     */
+    void setEvents(std::vector<Event>) override {
+        throw std::invalid_argument("SDESolver does not support events");
+    }
+
+    /**
+     * @brief Dense output of a path, with differences of the values as derivatives since the drift alone does not
+     * interpolate the path.
+     */
+    DenseOutput solveDense(double stepSize, double tEnd,
+                           DenseOutput::Order order = DenseOutput::Order::Cubic) override {
+        std::vector<double> y = solve(stepSize, tEnd);
+        std::vector<std::vector<double>> values(y.size());
+        for (unsigned int n = 0; n < y.size(); n++) {
+            values[n] = {y[n]};
+        }
+        return DenseOutput::fromValues(t0, stepSize, std::move(values), order);
+    }
+
+    /**
+     * @brief Solves the SDE along the given path.
+     * @param stepSize The step size.
+     * @param tEnd The time to solve the SDE to.
+     * @param index Number of the path.
+     * @return A vector of the solution at each step.
+     */
+    std::vector<double> path(double stepSize, double tEnd, std::uint64_t index) const;
+
+    /**
+     * @brief Values at tEnd of the paths 0, ..., paths - 1, equal to the last values of path().
+     * @param stepSize The step size.
+     * @param tEnd The time to solve the SDE to.
+     * @param paths Number of paths.
+     * @param pool Optional thread pool.
+     * @return The value of every path at tEnd.
+     */
+    std::vector<double> terminalValues(double stepSize, double tEnd, std::uint64_t paths,
+                                       const std::shared_ptr<ThreadPool>& pool = nullptr) const;
+
+    /**
+     * @brief Values at tEnd of path p with fineSteps steps and with fineSteps / 2 steps on the same Brownian path,
+     * every coarse increment being the sum of two fine ones, as needed for multilevel Monte Carlo. AdaptiveSRK makes
+     * steps of fixed size here.
+     * @param tEnd The time to solve the SDE to.
+     * @param fineSteps Number of fine steps, even.
+     * @param p Number of the path.
+     * @return The fine and the coarse value.
+     */
+    std::array<double, 2> coupledTerminalValues(double tEnd, unsigned int fineSteps, std::uint64_t p) const;
+
+    /**
+     * @brief The Brownian increment of step n of path p for the step size h.
+     */
+    double increment(std::uint64_t p, std::uint64_t n, double h) const { return std::sqrt(h) * rng.normal(p, n); }
+
+private:
+    std::function<double(double y, double t)> g;
+    std::function<double(double y, double t)> dg;
+    Method method;
+    Philox rng;
+    double tol;
+    unsigned int maxRefinements;
+
+    /**
+     * @brief One step of the method of fixed step size with the increment dW.
+     */
+    double step(double y, double t, double h, double dW) const;
+
+    /**
+     * @brief One step of the derivative-free Runge-Kutta-Milstein scheme.
+     */
+    double srkStep(double y, double t, double h, double dW) const;
+
+    /**
+     * @brief Step of AdaptiveSRK over [t, t + h] with the increment dW, refined by Brownian bridges.
+     * @param p     Path
+     * @param level Number of halvings of the base step
+     * @param node  Position of the step at its level, n * 2^level + j for the j-th part of base step n
+     */
+    double adaptiveStep(double y, double t, double h, double dW, std::uint64_t p, unsigned int level,
+                        std::uint64_t node) const;
+
+    /**
+     * @brief Advances the paths first, ..., first + count - 1 (count <= lanes) over N - 1 steps.
+     */
+    void advanceLanes(std::uint64_t first, unsigned int count, unsigned int N, double stepSize, double* y) const;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include "ODESolver.h"
+#include "ODESystemSolver.h"
+
+/**
+ * @brief Solves a scalar ODE with a solver for systems of ODEs of size one, so that system solvers can be
+ * used wherever an ODESolver is expected, e.g. in the configuration file.
+ */
+class ScalarSystemSolver : public ODESolver {
+
+public:
+    /**
+     * @brief Construct a ScalarSystemSolver object
+     *
+     * @param       f  Such that y' = f(y, t)
+     * @param  solver  Solver for the same ODE written as a system of size one
+     * @param      y0  Initial value of y
+     * @param      t0  Initial value of t
+     */
+    ScalarSystemSolver(std::function<double(double y, double t)> f, std::unique_ptr<ODESystemSolver> solver,
+                       double y0, double t0)
+            : ODESolver(std::move(f), y0, t0), solver(std::move(solver)) {}
+
+    /**
+     * @brief Solves the ODE with the wrapped system solver.
+     * @param stepSize The step size.
+     * @param tEnd The time to solve the ODE to.
+     * @return A vector of the solution at each step.
+     */
+    std::vector<double> solve(double stepSize, double tEnd) override {
+        std::vector<std::vector<double>> solution = solver->solve(stepSize, tEnd);
+        std::vector<double> y;
+        y.reserve(solution.size());
+        for (const std::vector<double>& value: solution) {
+            y.push_back(value[0]);
+        }
+        return y;
+    }
+
+    /**
+     * @brief Events are located and terminate the solve in the wrapped system solver.
+     */
+    void setEvents(std::vector<Event> events) override { solver->setEvents(std::move(events)); }
+
+    const std::vector<EventRecord>& eventLog() const override { return solver->eventLog(); }
+
+    /**
+     * @brief Wraps a scalar function f(y, t) as the right hand side of a system of size one.
+     */
+    static SystemFunction system(std::function<double(double y, double t)> f) {
+        return [f = std::move(f)](const std::vector<double>& y, double t, std::vector<double>& dydt) {
+            dydt[0] = f(y[0], t);
+        };
+    }
+
+private:
+    std::unique_ptr<ODESystemSolver> solver;
+};
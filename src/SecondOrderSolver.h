@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cmath>
+#include <utility>
+#include <vector>
+#include <functional>
+#include "DenseOutput.h"
+
+/**
+ * @brief Acceleration of a second order system, writes a(q, t) into a, which has the size of q.
+ */
+using AccelerationFunction = std::function<void(const std::vector<double>& q, double t, std::vector<double>& a)>;
+
+/**
+ * @brief Abstract interface for solving second order systems q'' = a(q, t), i.e. q' = v and v' = a(q, t).
+ *
+ * Positions and velocities are kept in two separate contiguous arrays (structure of arrays), so that updates
+ * of all particles run as vectorizable loops.
+ */
+class SecondOrderSolver {
+
+protected:
+    AccelerationFunction a;
+    std::vector<double> q0;
+    std::vector<double> v0;
+    double t0;
+
+protected:
+    /**
+     * @brief Construct an object derived from SecondOrderSolver.
+     *
+     * @param  a  Such that q'' = a(q, t)
+     * @param q0  Initial positions
+     * @param v0  Initial velocities
+     * @param t0  Initial value of t
+     */
+    SecondOrderSolver(AccelerationFunction a, std::vector<double> q0, std::vector<double> v0, double t0)
+            : a(std::move(a)), q0(std::move(q0)), v0(std::move(v0)), t0(t0) {}
+
+public:
+    /**
+     * @brief Positions and velocities at each step.
+     */
+    struct Solution {
+        std::vector<std::vector<double>> q;
+        std::vector<std::vector<double>> v;
+    };
+
+    /**
+     * @brief Advances positions and velocities in place by a number of steps without storing intermediate states.
+     * @param q         Positions, overwritten
+     * @param v         Velocities, overwritten
+     * @param t         Time of q and v
+     * @param stepSize  The step size.
+     * @param steps     Number of steps
+     */
+    virtual void advance(std::vector<double>& q, std::vector<double>& v, double t, double stepSize,
+                         unsigned long steps) = 0;
+
+    /**
+     * @brief Solves the system.
+     * @param stepSize The step size.
+     * @param tEnd The time to solve the system to.
+     * @return The positions and velocities at each step.
+     */
+    virtual Solution solve(double stepSize, double tEnd) {
+        unsigned int N = ceil((tEnd - t0) / stepSize) + 1;
+        Solution solution;
+        solution.q.reserve(N);
+        solution.v.reserve(N);
+        std::vector<double> q = q0;
+        std::vector<double> v = v0;
+        solution.q.push_back(q);
+        solution.v.push_back(v);
+        for (int n = 1; n < N; n++) {
+            advance(q, v, t0 + (n - 1) * stepSize, stepSize, 1);
+            solution.q.push_back(q);
+            solution.v.push_back(v);
+        }
+        return solution;
+    }
+
+    /**
+     * @brief Solves the system and returns the state (q, v) as a continuous function of t, with the exact
+     * derivatives (v, a(q, t)) at the steps.
+     * @param stepSize The step size.
+     * @param tEnd The time to solve the system to.
+     * @param order Cubic Hermite interpolation, or quintic to keep the accuracy of higher order methods.
+     * @return The dense output, the positions followed by the velocities.
+     */
+    virtual DenseOutput solveDense(double stepSize, double tEnd,
+                                   DenseOutput::Order order = DenseOutput::Order::Cubic) {
+        Solution solution = solve(stepSize, tEnd);
+        const unsigned int dim = q0.size();
+        std::vector<std::vector<double>> values(solution.q.size()), derivatives(solution.q.size());
+        std::vector<double> acceleration(dim);
+        for (unsigned int n = 0; n < solution.q.size(); n++) {
+            values[n] = solution.q[n];
+            values[n].insert(values[n].end(), solution.v[n].begin(), solution.v[n].end());
+            a(solution.q[n], t0 + n * stepSize, acceleration);
+            derivatives[n] = solution.v[n];
+            derivatives[n].insert(derivatives[n].end(), acceleration.begin(), acceleration.end());
+        }
+        return {t0, stepSize, std::move(values), std::move(derivatives), order};
+    }
+
+    virtual ~SecondOrderSolver() {} ;
+};
@@ -0,0 +1,284 @@
+#include "SparseLU.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <set>
+#include <stdexcept>
+
+void SparseLU::analyze(const CSRMatrix& A) {
+    if (A.rows != A.cols) {
+        throw std::invalid_argument("SparseLU requires a square matrix");
+    }
+    n = A.rows;
+    match = maximumMatching(A);
+    invMatch.resize(n);
+    for (unsigned int i = 0; i < n; i++) {
+        invMatch[match[i]] = i;
+    }
+
+    // Symmetrized pattern of B + B^T without the diagonal, B = Q A is the matched matrix
+    std::vector<std::vector<unsigned int>> adjacency(n);
+    for (unsigned int row = 0; row < n; row++) {
+        const unsigned int i = invMatch[row];
+        for (unsigned int p = A.rowPtr[row]; p < A.rowPtr[row + 1]; p++) {
+            unsigned int j = A.colIdx[p];
+            if (i != j) {
+                adjacency[i].push_back(j);
+                adjacency[j].push_back(i);
+            }
+        }
+    }
+    for (auto& neighbours: adjacency) {
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+    }
+
+    if (ordering == Ordering::MinimumDegree) {
+        perm = minimumDegreeOrdering(adjacency);
+    } else {
+        perm.resize(n);
+        for (unsigned int i = 0; i < n; i++) {
+            perm[i] = i;
+        }
+    }
+    invPerm.resize(n);
+    for (unsigned int i = 0; i < n; i++) {
+        invPerm[perm[i]] = i;
+    }
+
+    // Elimination tree of the permuted matrix (Liu's algorithm with path compression)
+    const unsigned int none = n;
+    std::vector<unsigned int> parent(n, none);
+    std::vector<unsigned int> ancestor(n, none);
+    for (unsigned int i = 0; i < n; i++) {
+        for (unsigned int neighbour: adjacency[perm[i]]) {
+            unsigned int r = invPerm[neighbour];
+            if (r >= i) {
+                continue;
+            }
+            while (ancestor[r] != none && ancestor[r] != i) {
+                unsigned int next = ancestor[r];
+                ancestor[r] = i;
+                r = next;
+            }
+            if (ancestor[r] == none) {
+                ancestor[r] = i;
+                parent[r] = i;
+            }
+        }
+    }
+
+    // Row patterns of L are the row subtrees of the elimination tree, U has the transposed pattern
+    std::vector<std::vector<unsigned int>> lowerRows(n);
+    std::vector<std::vector<unsigned int>> upperRows(n);
+    std::vector<unsigned int> mark(n, none);
+    for (unsigned int i = 0; i < n; i++) {
+        mark[i] = i;
+        for (unsigned int neighbour: adjacency[perm[i]]) {
+            unsigned int k = invPerm[neighbour];
+            while (k < i && mark[k] != i) {
+                lowerRows[i].push_back(k);
+                mark[k] = i;
+                k = parent[k];
+            }
+        }
+        std::sort(lowerRows[i].begin(), lowerRows[i].end());
+        for (unsigned int k: lowerRows[i]) {
+            upperRows[k].push_back(i);
+        }
+    }
+
+    rowPtr.assign(n + 1, 0);
+    diagPos.resize(n);
+    colIdx.clear();
+    for (unsigned int i = 0; i < n; i++) {
+        colIdx.insert(colIdx.end(), lowerRows[i].begin(), lowerRows[i].end());
+        diagPos[i] = colIdx.size();
+        colIdx.push_back(i);
+        colIdx.insert(colIdx.end(), upperRows[i].begin(), upperRows[i].end());
+        rowPtr[i + 1] = colIdx.size();
+    }
+    values.resize(colIdx.size());
+
+    scatter.resize(A.nonZeros());
+    for (unsigned int row = 0; row < n; row++) {
+        unsigned int i = invPerm[invMatch[row]];
+        auto begin = colIdx.begin() + rowPtr[i];
+        auto end = colIdx.begin() + rowPtr[i + 1];
+        for (unsigned int p = A.rowPtr[row]; p < A.rowPtr[row + 1]; p++) {
+            scatter[p] = std::lower_bound(begin, end, invPerm[A.colIdx[p]]) - colIdx.begin();
+        }
+    }
+
+    patternRowPtr = A.rowPtr;
+    patternColIdx = A.colIdx;
+    work.resize(n);
+    analyzed = true;
+}
+
+bool SparseLU::hasPattern(const CSRMatrix& A) const {
+    return analyzed && A.rows == n && A.rowPtr == patternRowPtr && A.colIdx == patternColIdx;
+}
+
+void SparseLU::factorize(const CSRMatrix& A) {
+    if (!hasPattern(A)) {
+        analyze(A);
+    }
+    if (factorizeNumeric(A)) {
+        return;
+    }
+    // The matching was chosen for other values, e.g. an entry that was nonzero in the last analysis
+    analyze(A);
+    if (!factorizeNumeric(A)) {
+        throw std::runtime_error("Zero pivot in sparse LU factorization");
+    }
+}
+
+bool SparseLU::factorizeNumeric(const CSRMatrix& A) {
+    std::fill(values.begin(), values.end(), 0.0);
+    for (unsigned int p = 0; p < A.nonZeros(); p++) {
+        values[scatter[p]] += A.values[p];
+    }
+
+    // Row-wise (IKJ) elimination, the symbolic factorization guarantees that every update hits a stored entry
+    std::vector<unsigned int> position(n);
+    for (unsigned int i = 0; i < n; i++) {
+        for (unsigned int p = rowPtr[i]; p < rowPtr[i + 1]; p++) {
+            position[colIdx[p]] = p;
+        }
+        for (unsigned int p = rowPtr[i]; p < diagPos[i]; p++) {
+            unsigned int k = colIdx[p];
+            double l_ik = values[p] / values[diagPos[k]];
+            values[p] = l_ik;
+            for (unsigned int q = diagPos[k] + 1; q < rowPtr[k + 1]; q++) {
+                values[position[colIdx[q]]] -= l_ik * values[q];
+            }
+        }
+        if (values[diagPos[i]] == 0.0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SparseLU::solve(std::vector<double>& b) const {
+    for (unsigned int i = 0; i < n; i++) {
+        work[i] = b[match[perm[i]]];
+    }
+    for (unsigned int i = 0; i < n; i++) {
+        double sum = work[i];
+        for (unsigned int p = rowPtr[i]; p < diagPos[i]; p++) {
+            sum -= values[p] * work[colIdx[p]];
+        }
+        work[i] = sum;
+    }
+    for (unsigned int i = n; i-- > 0;) {
+        double sum = work[i];
+        for (unsigned int p = diagPos[i] + 1; p < rowPtr[i + 1]; p++) {
+            sum -= values[p] * work[colIdx[p]];
+        }
+        work[i] = sum / values[diagPos[i]];
+    }
+    for (unsigned int i = 0; i < n; i++) {
+        b[perm[i]] = work[i];
+    }
+}
+
+std::vector<unsigned int> SparseLU::maximumMatching(const CSRMatrix& A) const {
+    // Candidate columns of every row: the diagonal first if it is nonzero, then the other nonzero entries by magnitude
+    std::vector<std::vector<unsigned int>> candidates(n);
+    std::vector<std::pair<double, unsigned int>> entries;
+    for (unsigned int row = 0; row < n; row++) {
+        entries.clear();
+        for (unsigned int p = A.rowPtr[row]; p < A.rowPtr[row + 1]; p++) {
+            if (A.values[p] != 0.0) {
+                double weight = A.colIdx[p] == row ? std::numeric_limits<double>::infinity() : std::abs(A.values[p]);
+                entries.emplace_back(-weight, A.colIdx[p]);
+            }
+        }
+        std::sort(entries.begin(), entries.end());
+        for (const auto& entry: entries) {
+            candidates[row].push_back(entry.second);
+        }
+    }
+
+    // Nonzero diagonal entries are kept, the other rows are matched along augmenting paths (MC21)
+    const unsigned int none = n;
+    std::vector<unsigned int> owner(n, none);
+    std::vector<bool> matched(n, false);
+    for (unsigned int row = 0; row < n; row++) {
+        if (!candidates[row].empty() && candidates[row][0] == row) {
+            owner[row] = row;
+            matched[row] = true;
+        }
+    }
+    std::vector<unsigned int> visited(n, none);
+    std::function<bool(unsigned int, unsigned int)> augment = [&](unsigned int row, unsigned int search) {
+        for (unsigned int column: candidates[row]) {
+            if (owner[column] == none) {
+                owner[column] = row;
+                return true;
+            }
+        }
+        for (unsigned int column: candidates[row]) {
+            if (visited[column] != search) {
+                visited[column] = search;
+                if (augment(owner[column], search)) {
+                    owner[column] = row;
+                    return true;
+                }
+            }
+        }
+        return false;
+    };
+    for (unsigned int row = 0; row < n; row++) {
+        if (!matched[row]) {
+            matched[row] = augment(row, row);
+        }
+    }
+
+    // Structurally singular matrices keep the remaining rows in arbitrary free columns, their pivots are zero
+    unsigned int column = 0;
+    for (unsigned int row = 0; row < n; row++) {
+        if (!matched[row]) {
+            while (owner[column] != none) {
+                column++;
+            }
+            owner[column] = row;
+        }
+    }
+    return owner;
+}
+
+std::vector<unsigned int>
+SparseLU::minimumDegreeOrdering(const std::vector<std::vector<unsigned int>>& adjacency) const {
+    // Greedy minimum degree on the explicit elimination graph: eliminating a node turns its neighbours into a clique
+    std::vector<std::vector<unsigned int>> graph(adjacency);
+    std::set<std::pair<unsigned int, unsigned int>> queue;
+    for (unsigned int i = 0; i < n; i++) {
+        queue.emplace(graph[i].size(), i);
+    }
+    std::vector<unsigned int> order;
+    order.reserve(n);
+    std::vector<unsigned int> merged;
+    while (!queue.empty()) {
+        unsigned int v = queue.begin()->second;
+        queue.erase(queue.begin());
+        order.push_back(v);
+        const std::vector<unsigned int>& clique = graph[v];
+        for (unsigned int u: clique) {
+            queue.erase({graph[u].size(), u});
+            merged.clear();
+            std::set_union(graph[u].begin(), graph[u].end(), clique.begin(), clique.end(), std::back_inserter(merged));
+            merged.erase(std::remove_if(merged.begin(), merged.end(), [u, v](unsigned int w) {
+                return w == u || w == v;
+            }), merged.end());
+            graph[u].swap(merged);
+            queue.emplace(graph[u].size(), u);
+        }
+        graph[v].clear();
+        graph[v].shrink_to_fit();
+    }
+    return order;
+}
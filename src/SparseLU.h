@@ -0,0 +1,99 @@
+#pragma once
+
+#include <vector>
+#include "SparseMatrix.h"
+
+/**
+ * @brief Sparse LU factorization of square CSR matrices.
+ *
+ * The factorization is split into an analysis phase (fill-reducing ordering and symbolic factorization),
+ * which only depends on the sparsity pattern, and a numeric phase, which can be repeated whenever the values
+ * change while the pattern stays the same (e.g. across Newton iterations and time steps of an implicit solver).
+ *
+ * The analysis first permutes the rows so that the diagonal is free of zeros, by a maximum matching of rows and
+ * columns on the nonzero entries that keeps nonzero diagonal entries and otherwise prefers large ones. A symmetric
+ * permutation P Q A P^T = L U of the matched matrix is then factorized without numerical pivoting. This is safe for
+ * diagonally dominant matrices such as the Newton matrices I - gamma * J of implicit methods with moderate step sizes,
+ * and in practice for M - gamma * J of index 1 DAEs, whose algebraic rows often have a zero diagonal. A zero pivot in the numeric phase
+ * repeats the analysis with the matching of the current values once before it is reported.
+ */
+class SparseLU {
+
+public:
+    enum class Ordering {
+        Natural,
+        MinimumDegree
+    };
+
+    /**
+     * @brief Construct a SparseLU object
+     *
+     * @param ordering  Fill-reducing ordering used during the analysis
+     */
+    explicit SparseLU(Ordering ordering = Ordering::MinimumDegree) : ordering(ordering) {}
+
+    /**
+     * @brief Computes the row matching, the ordering and the symbolic factorization of A.
+     * @param A Square matrix, the values are only used to choose the matching.
+     */
+    void analyze(const CSRMatrix& A);
+
+    /**
+     * @brief Computes the numeric factorization of A, reusing the symbolic factorization if the pattern is unchanged.
+     * @param A Square matrix.
+     */
+    void factorize(const CSRMatrix& A);
+
+    /**
+     * @brief Solves A x = b with the current factorization.
+     * @param b Right hand side, overwritten with the solution.
+     */
+    void solve(std::vector<double>& b) const;
+
+    /**
+     * @brief Whether A has the pattern of the last analyzed matrix.
+     */
+    bool hasPattern(const CSRMatrix& A) const;
+
+    /**
+     * @brief Number of stored entries of L + U, including fill-in.
+     */
+    unsigned int factorNonZeros() const { return colIdx.size(); }
+
+    /**
+     * @brief The ordering, i.e. column i of the factorized matrix is column permutation()[i] of A.
+     */
+    const std::vector<unsigned int>& permutation() const { return perm; }
+
+    /**
+     * @brief The row matching, row i of the matched matrix Q A is row rowMatching()[i] of A.
+     */
+    const std::vector<unsigned int>& rowMatching() const { return match; }
+
+private:
+    Ordering ordering;
+    unsigned int n = 0;
+    bool analyzed = false;
+    std::vector<unsigned int> perm;
+    std::vector<unsigned int> invPerm;
+    // Row matching, row i of Q A is row match[i] of A, and row r of A is row invMatch[r] of Q A
+    std::vector<unsigned int> match;
+    std::vector<unsigned int> invMatch;
+    // Pattern of the analyzed matrix
+    std::vector<unsigned int> patternRowPtr;
+    std::vector<unsigned int> patternColIdx;
+    // L (unit lower, diagonal not stored) and U stored together row-wise in the permuted order
+    std::vector<unsigned int> rowPtr;
+    std::vector<unsigned int> colIdx;
+    std::vector<unsigned int> diagPos;
+    std::vector<double> values;
+    // Position of every entry of A in the factor
+    std::vector<unsigned int> scatter;
+    mutable std::vector<double> work;
+
+    bool factorizeNumeric(const CSRMatrix& A);
+
+    std::vector<unsigned int> maximumMatching(const CSRMatrix& A) const;
+
+    std::vector<unsigned int> minimumDegreeOrdering(const std::vector<std::vector<unsigned int>>& adjacency) const;
+};
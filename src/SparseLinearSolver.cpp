@@ -0,0 +1,13 @@
+#include "SparseLinearSolver.h"
+
+void SparseLinearSolver::setup(const std::vector<double>& y, double t, double gamma) {
+    jacobian(y, t, J);
+    if (mass) {
+        mass(y, t, M);
+    }
+    lu.factorize(newtonMatrix.assemble(J, gamma, mass ? &M : nullptr));
+}
+
+void SparseLinearSolver::solve(std::vector<double>& b) {
+    lu.solve(b);
+}
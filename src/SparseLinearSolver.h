@@ -0,0 +1,45 @@
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include "LinearSolver.h"
+#include "SparseMatrix.h"
+#include "SparseLU.h"
+#include "SparseNewtonMatrix.h"
+
+/**
+ * @brief Solves the Newton systems with a sparse Jacobian and SparseLU.
+ *
+ * The ordering and symbolic factorization are computed on the first setup and reused as long as the Jacobian
+ * pattern does not change, later setups only refactorize numerically.
+ */
+class SparseLinearSolver : public LinearSolver {
+
+public:
+    /**
+     * @brief Construct a SparseLinearSolver object
+     *
+     * @param jacobian  Such that jacobian(y, t) = df(y, t)/dy
+     * @param ordering  Fill-reducing ordering of the factorization
+     */
+    explicit SparseLinearSolver(SparseJacobianFunction jacobian,
+                                SparseLU::Ordering ordering = SparseLU::Ordering::MinimumDegree)
+            : jacobian(std::move(jacobian)), lu(ordering) {}
+
+    void setup(const std::vector<double>& y, double t, double gamma) override;
+
+    void solve(std::vector<double>& b) override;
+
+    using LinearSolver::solve;
+
+    void setMassMatrix(MassMatrixFunction mass) override { this->mass = std::move(mass); }
+
+private:
+    MassMatrixFunction mass;
+    CSRMatrix M;
+    SparseJacobianFunction jacobian;
+    CSRMatrix J;
+    SparseNewtonMatrix newtonMatrix;
+    SparseLU lu;
+};
@@ -0,0 +1,126 @@
+#include "SparseMatrix.h"
+#include <algorithm>
+#include <stdexcept>
+
+CSRMatrix CSRMatrix::fromTriplets(unsigned int rows, unsigned int cols, const std::vector<Triplet>& triplets) {
+    std::vector<Triplet> sorted(triplets);
+    std::sort(sorted.begin(), sorted.end(), [](const Triplet& a, const Triplet& b) {
+        return a.row < b.row || (a.row == b.row && a.col < b.col);
+    });
+    CSRMatrix A;
+    A.rows = rows;
+    A.cols = cols;
+    A.rowPtr.assign(rows + 1, 0);
+    A.colIdx.reserve(sorted.size());
+    A.values.reserve(sorted.size());
+    for (unsigned int k = 0; k < sorted.size(); k++) {
+        const Triplet& entry = sorted[k];
+        if (entry.row >= rows || entry.col >= cols) {
+            throw std::invalid_argument("Triplet index out of range");
+        }
+        if (k > 0 && entry.row == sorted[k - 1].row && entry.col == sorted[k - 1].col) {
+            A.values.back() += entry.value;
+            continue;
+        }
+        A.colIdx.push_back(entry.col);
+        A.values.push_back(entry.value);
+        A.rowPtr[entry.row + 1]++;
+    }
+    for (unsigned int i = 0; i < rows; i++) {
+        A.rowPtr[i + 1] += A.rowPtr[i];
+    }
+    return A;
+}
+
+CSRMatrix CSRMatrix::identity(unsigned int n) {
+    CSRMatrix A;
+    A.rows = n;
+    A.cols = n;
+    A.rowPtr.resize(n + 1);
+    A.colIdx.resize(n);
+    A.values.assign(n, 1.0);
+    for (unsigned int i = 0; i < n; i++) {
+        A.rowPtr[i] = i;
+        A.colIdx[i] = i;
+    }
+    A.rowPtr[n] = n;
+    return A;
+}
+
+int CSRMatrix::find(unsigned int row, unsigned int col) const {
+    auto begin = colIdx.begin() + rowPtr[row];
+    auto end = colIdx.begin() + rowPtr[row + 1];
+    auto it = std::lower_bound(begin, end, col);
+    if (it == end || *it != col) {
+        return -1;
+    }
+    return static_cast<int>(it - colIdx.begin());
+}
+
+void CSRMatrix::multiply(const std::vector<double>& x, std::vector<double>& y) const {
+    y.resize(rows);
+    for (unsigned int i = 0; i < rows; i++) {
+        double sum = 0.0;
+        for (unsigned int p = rowPtr[i]; p < rowPtr[i + 1]; p++) {
+            sum += values[p] * x[colIdx[p]];
+        }
+        y[i] = sum;
+    }
+}
+
+CSCMatrix CSRMatrix::toCSC() const {
+    CSCMatrix A;
+    A.rows = rows;
+    A.cols = cols;
+    A.colPtr.assign(cols + 1, 0);
+    A.rowIdx.resize(nonZeros());
+    A.values.resize(nonZeros());
+    for (unsigned int col: colIdx) {
+        A.colPtr[col + 1]++;
+    }
+    for (unsigned int j = 0; j < cols; j++) {
+        A.colPtr[j + 1] += A.colPtr[j];
+    }
+    std::vector<unsigned int> next(A.colPtr.begin(), A.colPtr.end() - 1);
+    for (unsigned int i = 0; i < rows; i++) {
+        for (unsigned int p = rowPtr[i]; p < rowPtr[i + 1]; p++) {
+            unsigned int q = next[colIdx[p]]++;
+            A.rowIdx[q] = i;
+            A.values[q] = values[p];
+        }
+    }
+    return A;
+}
+
+void CSCMatrix::multiply(const std::vector<double>& x, std::vector<double>& y) const {
+    y.assign(rows, 0.0);
+    for (unsigned int j = 0; j < cols; j++) {
+        for (unsigned int p = colPtr[j]; p < colPtr[j + 1]; p++) {
+            y[rowIdx[p]] += values[p] * x[j];
+        }
+    }
+}
+
+CSRMatrix CSCMatrix::toCSR() const {
+    CSRMatrix A;
+    A.rows = rows;
+    A.cols = cols;
+    A.rowPtr.assign(rows + 1, 0);
+    A.colIdx.resize(nonZeros());
+    A.values.resize(nonZeros());
+    for (unsigned int row: rowIdx) {
+        A.rowPtr[row + 1]++;
+    }
+    for (unsigned int i = 0; i < rows; i++) {
+        A.rowPtr[i + 1] += A.rowPtr[i];
+    }
+    std::vector<unsigned int> next(A.rowPtr.begin(), A.rowPtr.end() - 1);
+    for (unsigned int j = 0; j < cols; j++) {
+        for (unsigned int p = colPtr[j]; p < colPtr[j + 1]; p++) {
+            unsigned int q = next[rowIdx[p]]++;
+            A.colIdx[q] = j;
+            A.values[q] = values[p];
+        }
+    }
+    return A;
+}
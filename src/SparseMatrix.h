@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+
+struct CSCMatrix;
+
+/**
+ * @brief Single entry of a sparse matrix given in coordinate format.
+ */
+struct Triplet {
+    unsigned int row;
+    unsigned int col;
+    double value;
+};
+
+/**
+ * @brief Sparse matrix in compressed sparse row (CSR) format.
+ *
+ * The column indices of every row are stored in ascending order and without duplicates.
+ */
+struct CSRMatrix {
+    unsigned int rows = 0;
+    unsigned int cols = 0;
+    std::vector<unsigned int> rowPtr;
+    std::vector<unsigned int> colIdx;
+    std::vector<double> values;
+
+    /**
+     * @brief Builds a CSR matrix from unordered triplets, summing duplicate entries.
+     *
+     * @param rows      Number of rows
+     * @param cols      Number of columns
+     * @param triplets  Entries of the matrix
+     * @return The assembled matrix.
+     */
+    static CSRMatrix fromTriplets(unsigned int rows, unsigned int cols, const std::vector<Triplet>& triplets);
+
+    /**
+     * @brief Creates the n x n identity matrix.
+     */
+    static CSRMatrix identity(unsigned int n);
+
+    /**
+     * @brief Number of stored entries.
+     */
+    unsigned int nonZeros() const { return colIdx.size(); }
+
+    /**
+     * @brief Position of entry (row, col) in colIdx/values, or -1 if it is not stored.
+     */
+    int find(unsigned int row, unsigned int col) const;
+
+    /**
+     * @brief Computes y = A * x.
+     */
+    void multiply(const std::vector<double>& x, std::vector<double>& y) const;
+
+    /**
+     * @brief Converts the matrix to compressed sparse column format.
+     */
+    CSCMatrix toCSC() const;
+};
+
+/**
+ * @brief Sparse matrix in compressed sparse column (CSC) format.
+ *
+ * The row indices of every column are stored in ascending order and without duplicates.
+ */
+struct CSCMatrix {
+    unsigned int rows = 0;
+    unsigned int cols = 0;
+    std::vector<unsigned int> colPtr;
+    std::vector<unsigned int> rowIdx;
+    std::vector<double> values;
+
+    /**
+     * @brief Number of stored entries.
+     */
+    unsigned int nonZeros() const { return rowIdx.size(); }
+
+    /**
+     * @brief Computes y = A * x.
+     */
+    void multiply(const std::vector<double>& x, std::vector<double>& y) const;
+
+    /**
+     * @brief Converts the matrix to compressed sparse row format.
+     */
+    CSRMatrix toCSR() const;
+};
@@ -0,0 +1,60 @@
+#include "SparseNewtonMatrix.h"
+#include <algorithm>
+
+void SparseNewtonMatrix::buildPattern(const CSRMatrix& J, const CSRMatrix* M) {
+    std::vector<Triplet> triplets;
+    triplets.reserve(J.nonZeros() + J.rows + (M ? M->nonZeros() : 0));
+    for (unsigned int i = 0; i < J.rows; i++) {
+        triplets.push_back({i, i, 0.0});
+        for (unsigned int p = J.rowPtr[i]; p < J.rowPtr[i + 1]; p++) {
+            triplets.push_back({i, J.colIdx[p], 0.0});
+        }
+        if (M) {
+            for (unsigned int p = M->rowPtr[i]; p < M->rowPtr[i + 1]; p++) {
+                triplets.push_back({i, M->colIdx[p], 0.0});
+            }
+        }
+    }
+    newtonMatrix = CSRMatrix::fromTriplets(J.rows, J.cols, triplets);
+    jacobianPos.resize(J.nonZeros());
+    for (unsigned int i = 0; i < J.rows; i++) {
+        for (unsigned int p = J.rowPtr[i]; p < J.rowPtr[i + 1]; p++) {
+            jacobianPos[p] = newtonMatrix.find(i, J.colIdx[p]);
+        }
+    }
+    massPos.resize(M ? M->nonZeros() : 0);
+    for (unsigned int i = 0; M && i < M->rows; i++) {
+        for (unsigned int p = M->rowPtr[i]; p < M->rowPtr[i + 1]; p++) {
+            massPos[p] = newtonMatrix.find(i, M->colIdx[p]);
+        }
+    }
+    diagonalPos.resize(J.rows);
+    for (unsigned int i = 0; i < J.rows; i++) {
+        diagonalPos[i] = newtonMatrix.find(i, i);
+    }
+    jacobianRowPtr = J.rowPtr;
+    jacobianColIdx = J.colIdx;
+    massRowPtr = M ? M->rowPtr : std::vector<unsigned int>();
+    massColIdx = M ? M->colIdx : std::vector<unsigned int>();
+}
+
+const CSRMatrix& SparseNewtonMatrix::assemble(const CSRMatrix& J, double gamma, const CSRMatrix* M) {
+    const bool massChanged = M ? M->rowPtr != massRowPtr || M->colIdx != massColIdx : !massRowPtr.empty();
+    if (J.rowPtr != jacobianRowPtr || J.colIdx != jacobianColIdx || massChanged) {
+        buildPattern(J, M);
+    }
+    std::fill(newtonMatrix.values.begin(), newtonMatrix.values.end(), 0.0);
+    for (unsigned int p = 0; p < J.nonZeros(); p++) {
+        newtonMatrix.values[jacobianPos[p]] = -gamma * J.values[p];
+    }
+    if (M) {
+        for (unsigned int p = 0; p < M->nonZeros(); p++) {
+            newtonMatrix.values[massPos[p]] += M->values[p];
+        }
+    } else {
+        for (unsigned int pos: diagonalPos) {
+            newtonMatrix.values[pos] += 1.0;
+        }
+    }
+    return newtonMatrix;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+#include "SparseMatrix.h"
+
+/**
+ * @brief Jacobian of a system of ODEs in CSR format, writes df(y, t)/dy into J.
+ *
+ * J keeps the matrix of the previous call, so a function that only updates J.values keeps the pattern and with it
+ * the symbolic factorizations built on it.
+ */
+using SparseJacobianFunction = std::function<void(const std::vector<double>& y, double t, CSRMatrix& J)>;
+
+/**
+ * @brief Assembles the Newton matrix I - gamma * J, or M - gamma * J with a mass matrix M, from a sparse Jacobian J.
+ *
+ * The pattern of the Newton matrix (the patterns of J and M plus the diagonal) is built once and reused as long as
+ * the patterns of J and M do not change, so that factorizations depending only on the pattern can be reused as well.
+ * The diagonal is always part of the pattern, also where M has zero rows.
+ */
+class SparseNewtonMatrix {
+
+public:
+    /**
+     * @brief Assembles I - gamma * J, or M - gamma * J if M is given.
+     * @param J     Jacobian
+     * @param gamma Scaling of the Jacobian
+     * @param M     Optional mass matrix
+     * @return The Newton matrix, valid until the next call.
+     */
+    const CSRMatrix& assemble(const CSRMatrix& J, double gamma, const CSRMatrix* M = nullptr);
+
+    /**
+     * @brief The last assembled Newton matrix.
+     */
+    const CSRMatrix& matrix() const { return newtonMatrix; }
+
+private:
+    CSRMatrix newtonMatrix;
+    // Positions of the entries of J, of M and of the diagonal in newtonMatrix
+    std::vector<unsigned int> jacobianPos;
+    std::vector<unsigned int> massPos;
+    std::vector<unsigned int> diagonalPos;
+    std::vector<unsigned int> jacobianRowPtr;
+    std::vector<unsigned int> jacobianColIdx;
+    std::vector<unsigned int> massRowPtr;
+    std::vector<unsigned int> massColIdx;
+
+    void buildPattern(const CSRMatrix& J, const CSRMatrix* M);
+};
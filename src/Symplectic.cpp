@@ -0,0 +1,85 @@
+#include "Symplectic.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Computes y += c * x for arrays of length n.
+ */
+static inline void addScaled(double* __restrict y, const double* __restrict x, double c, unsigned int n) {
+    for (unsigned int i = 0; i < n; i++) {
+        y[i] += c * x[i];
+    }
+}
+
+/**
+ * @brief Symmetric composition weights w_k, ..., w_1, w_0, w_1, ..., w_k from the k weights w_1, ..., w_k.
+ */
+static std::vector<double> symmetricComposition(const std::vector<double>& outer) {
+    double w0 = 1.0;
+    for (double w: outer) {
+        w0 -= 2 * w;
+    }
+    std::vector<double> weights(outer.rbegin(), outer.rend());
+    weights.push_back(w0);
+    weights.insert(weights.end(), outer.begin(), outer.end());
+    return weights;
+}
+
+Symplectic::Symplectic(AccelerationFunction a, std::vector<double> q0, std::vector<double> v0, double t0,
+                       Method method) : SecondOrderSolver(std::move(a), std::move(q0), std::move(v0), t0),
+                                        method(method) {
+    switch (method) {
+        case Method::StormerVerlet:
+            weights = {1.0};
+            break;
+        case Method::Yoshida4:
+            weights = symmetricComposition({1 / (2 - std::cbrt(2.0))});
+            break;
+        case Method::Yoshida6:
+            weights = symmetricComposition({-0.117767998417887e1, 0.235573213359357e0, 0.784513610477560e0});
+            break;
+        case Method::Yoshida8:
+            weights = symmetricComposition({0.102799849391985e0, -0.196061023297549e1, 0.193813913762276e1,
+                                            -0.158240635368243e0, -0.144485223686048e1, 0.253693336566229e0,
+                                            0.914844246229740e0});
+            break;
+    }
+}
+
+unsigned int Symplectic::order() const {
+    switch (method) {
+        case Method::StormerVerlet:
+            return 2;
+        case Method::Yoshida4:
+            return 4;
+        case Method::Yoshida6:
+            return 6;
+        default:
+            return 8;
+    }
+}
+
+void Symplectic::advance(std::vector<double>& q, std::vector<double>& v, double t, double stepSize,
+                         unsigned long steps) {
+    const unsigned int n = q.size();
+    // The acceleration at the end of the previous call is reused when continuing from its final state
+    if (q != cachedQ || std::abs(t - cachedT) > 1e-12 * (1 + std::abs(t))) {
+        acceleration.resize(n);
+        a(q, t, acceleration);
+    }
+    for (unsigned long step = 0; step < steps; step++) {
+        double tStep = t + step * stepSize;
+        double tSub = tStep;
+        for (double w: weights) {
+            double h = w * stepSize;
+            // The closing half kick of a substage and the opening one of the next share the acceleration
+            addScaled(v.data(), acceleration.data(), h / 2, n);
+            addScaled(q.data(), v.data(), h, n);
+            tSub += h;
+            a(q, tSub, acceleration);
+            addScaled(v.data(), acceleration.data(), h / 2, n);
+        }
+    }
+    cachedQ = q;
+    cachedT = t + steps * stepSize;
+}
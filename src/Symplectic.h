@@ -0,0 +1,52 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+#include "SecondOrderSolver.h"
+
+/**
+ * @brief Class for solving separable second order systems with symplectic composition methods.
+ *
+ * The basic step is the Stoermer-Verlet (kick-drift-kick) method. The higher order methods are Yoshida's symmetric
+ * compositions of Verlet steps with the weights of Yoshida (1990): the triple jump for order 4 and the solutions A
+ * (order 6) and D (order 8). Consecutive half kicks share one evaluation of the acceleration, so a step costs one
+ * evaluation per Verlet substage. Stepping does not allocate memory, and the acceleration of the final state is
+ * kept so that advancing step by step costs no extra evaluations.
+ */
+class Symplectic : public SecondOrderSolver {
+
+public:
+    enum class Method {
+        StormerVerlet,
+        Yoshida4,
+        Yoshida6,
+        Yoshida8
+    };
+
+    /**
+     * @brief Construct a Symplectic object
+     *
+     * @param      a  Such that q'' = a(q, t)
+     * @param     q0  Initial positions
+     * @param     v0  Initial velocities
+     * @param     t0  Initial value of t
+     * @param method  Composition method
+     */
+    Symplectic(AccelerationFunction a, std::vector<double> q0, std::vector<double> v0, double t0,
+               Method method = Method::Yoshida4);
+
+    void advance(std::vector<double>& q, std::vector<double>& v, double t, double stepSize,
+                 unsigned long steps) override;
+
+    /**
+     * @brief Order of the composition method.
+     */
+    unsigned int order() const;
+
+private:
+    Method method;
+    std::vector<double> weights;
+    std::vector<double> acceleration;
+    std::vector<double> cachedQ;
+    double cachedT = NAN;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Fixed set of worker threads executing submitted tasks in submission order.
+ *
+ * Tasks must not wait for other tasks of the same pool, since all workers may be blocked waiting.
+ */
+class ThreadPool {
+
+public:
+    /**
+     * @brief Construct a ThreadPool object
+     *
+     * @param threads Number of worker threads, at least one
+     */
+    explicit ThreadPool(unsigned int threads = std::thread::hardware_concurrency());
+
+    /**
+     * @brief Finishes the queued tasks and joins the workers.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queues a task for execution on a worker thread.
+     * @param task Callable without arguments
+     * @return A future holding the result of the task, exceptions of the task are rethrown by get()
+     */
+    template<class F>
+    std::future<std::invoke_result_t<F>> submit(F task) {
+        auto packaged = std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::move(task));
+        std::future<std::invoke_result_t<F>> result = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.emplace([packaged]() { (*packaged)(); });
+        }
+        available.notify_one();
+        return result;
+    }
+
+    /**
+     * @brief Number of worker threads.
+     */
+    unsigned int size() const { return workers.size(); }
+
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping = false;
+
+    void work();
+};
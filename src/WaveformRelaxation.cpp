@@ -0,0 +1,177 @@
+#include "WaveformRelaxation.h"
+#include <algorithm>
+#include <future>
+#include <stdexcept>
+
+/**
+ * @brief The full right hand side assembled from the partitions.
+ */
+static SystemFunction combined(WaveformRelaxation::PartitionFunction f,
+                               std::vector<WaveformRelaxation::Partition> partitions) {
+    return [f = std::move(f), partitions = std::move(partitions)](const std::vector<double>& y, double t,
+                                                                  std::vector<double>& dydt) {
+        std::vector<double> z, coupling, local;
+        for (unsigned int p = 0; p < partitions.size(); p++) {
+            const std::vector<unsigned int>& components = partitions[p].components;
+            z.resize(components.size());
+            local.resize(components.size());
+            coupling.resize(partitions[p].coupling.size());
+            for (unsigned int i = 0; i < components.size(); i++) {
+                z[i] = y[components[i]];
+            }
+            for (unsigned int i = 0; i < coupling.size(); i++) {
+                coupling[i] = y[partitions[p].coupling[i]];
+            }
+            f(p, z, coupling, t, local);
+            for (unsigned int i = 0; i < local.size(); i++) {
+                dydt[components[i]] = local[i];
+            }
+        }
+    };
+}
+
+WaveformRelaxation::WaveformRelaxation(PartitionFunction f, std::vector<Partition> partitions,
+                                       std::vector<double> y0, double t0, ODESystemSolverFactory solver,
+                                       unsigned int windowSteps, Method method, std::shared_ptr<ThreadPool> pool,
+                                       double tol, unsigned int maxIterations)
+        : ODESystemSolver(combined(f, partitions), std::move(y0), t0), partitionFunction(std::move(f)),
+          partitions(std::move(partitions)), solver(std::move(solver)), windowSteps(windowSteps), method(method),
+          pool(std::move(pool)), tol(tol), maxIterations(maxIterations) {
+    if (windowSteps == 0) {
+        throw std::invalid_argument("Waveform relaxation windows need at least one step");
+    }
+    const unsigned int n = this->y0.size();
+    owner.assign(n, this->partitions.size());
+    position.assign(n, 0);
+    for (unsigned int p = 0; p < this->partitions.size(); p++) {
+        const std::vector<unsigned int>& components = this->partitions[p].components;
+        for (unsigned int i = 0; i < components.size(); i++) {
+            if (components[i] >= n || owner[components[i]] != this->partitions.size()) {
+                throw std::invalid_argument("Every component must belong to exactly one partition");
+            }
+            owner[components[i]] = p;
+            position[components[i]] = i;
+        }
+    }
+    if (std::find(owner.begin(), owner.end(), this->partitions.size()) != owner.end()) {
+        throw std::invalid_argument("Every component must belong to exactly one partition");
+    }
+}
+
+std::vector<std::vector<double>>
+WaveformRelaxation::integrate(const std::vector<std::vector<std::vector<double>>>& waves, unsigned int p,
+                              double tWindow, double stepSize, unsigned int steps) const {
+    const Partition& partition = partitions[p];
+    const unsigned int nodes = std::min(4u, steps + 1);
+    SystemFunction local = [&](const std::vector<double>& z, double t, std::vector<double>& dz) {
+        // Interpolated coupling values, per thread as Jacobi partitions run on the pool and their solvers may too
+        thread_local std::vector<double> coupling;
+        coupling.resize(partition.coupling.size());
+        // Lagrange interpolation of the coupling variables on the steps around t
+        double weights[4];
+        double x = (t - tWindow) / stepSize;
+        int first = std::clamp(static_cast<int>(std::floor(x)) - 1, 0, static_cast<int>(steps + 1 - nodes));
+        for (unsigned int j = 0; j < nodes; j++) {
+            weights[j] = 1.0;
+            for (unsigned int m = 0; m < nodes; m++) {
+                if (m != j) {
+                    weights[j] *= (x - first - m) / (static_cast<double>(j) - m);
+                }
+            }
+        }
+        for (unsigned int i = 0; i < coupling.size(); i++) {
+            const unsigned int c = partition.coupling[i];
+            const std::vector<std::vector<double>>& wave = waves[owner[c]];
+            coupling[i] = 0.0;
+            for (unsigned int j = 0; j < nodes; j++) {
+                coupling[i] += weights[j] * wave[first + j][position[c]];
+            }
+        }
+        partitionFunction(p, z, coupling, t, dz);
+    };
+    std::vector<std::vector<double>> wave = solver(local, waves[p][0], tWindow)->solve(stepSize,
+                                                                                     tWindow + steps * stepSize);
+    if (wave.size() < steps + 1) {
+        throw std::runtime_error("Partition solver stopped before the end of the window");
+    }
+    wave.resize(steps + 1);
+    return wave;
+}
+
+std::vector<std::vector<double>> WaveformRelaxation::solve(double stepSize, double tEnd) {
+    unsigned int N = ceil((tEnd - t0) / stepSize) + 1;
+    const unsigned int P = partitions.size();
+    totalIterations = 0;
+    std::vector<std::vector<double>> y;
+    y.reserve(N);
+    y.push_back(y0);
+    std::vector<std::vector<std::vector<double>>> waves(P);
+    for (unsigned int start = 0; start + 1 < N; start += windowSteps) {
+        const unsigned int steps = std::min(windowSteps, N - 1 - start);
+        const double tWindow = t0 + start * stepSize;
+        // Constant initial waveforms
+        for (unsigned int p = 0; p < P; p++) {
+            std::vector<double> initial(partitions[p].components.size());
+            for (unsigned int i = 0; i < initial.size(); i++) {
+                initial[i] = y.back()[partitions[p].components[i]];
+            }
+            waves[p].assign(steps + 1, initial);
+        }
+        for (unsigned int iteration = 0; iteration < maxIterations; iteration++) {
+            totalIterations++;
+            std::vector<std::vector<std::vector<double>>> next(P);
+            if (method == Method::Jacobi && pool) {
+                std::vector<std::future<void>> pending;
+                for (unsigned int p = 0; p < P; p++) {
+                    pending.push_back(pool->submit([&, p]() {
+                        next[p] = integrate(waves, p, tWindow, stepSize, steps);
+                    }));
+                }
+                for (std::future<void>& task: pending) {
+                    task.get();
+                }
+            } else {
+                for (unsigned int p = 0; p < P; p++) {
+                    next[p] = integrate(waves, p, tWindow, stepSize, steps);
+                    if (method == Method::GaussSeidel) {
+                        std::swap(next[p], waves[p]);
+                    }
+                }
+            }
+            double change = 0.0;
+            for (unsigned int p = 0; p < P; p++) {
+                // After Gauss-Seidel the new waveforms are already in waves and next holds the old ones
+                for (unsigned int k = 0; k <= steps; k++) {
+                    for (unsigned int i = 0; i < next[p][k].size(); i++) {
+                        double newValue = method == Method::GaussSeidel ? waves[p][k][i] : next[p][k][i];
+                        change = std::max(change, std::abs(next[p][k][i] - waves[p][k][i]) /
+                                                  (1 + std::abs(newValue)));
+                    }
+                }
+            }
+            if (method == Method::Jacobi) {
+                waves = std::move(next);
+            }
+            if (change <= tol) {
+                break;
+            }
+            if (iteration + 1 == maxIterations) {
+                throw std::runtime_error("Waveform relaxation did not converge");
+            }
+        }
+        for (unsigned int k = 1; k <= steps; k++) {
+            std::vector<double> value(y0.size());
+            for (unsigned int p = 0; p < P; p++) {
+                for (unsigned int i = 0; i < partitions[p].components.size(); i++) {
+                    value[partitions[p].components[i]] = waves[p][k][i];
+                }
+            }
+            y.push_back(std::move(value));
+            const double tNext = t0 + (start + k) * stepSize;
+            if (events && stopAtEvent(y, tNext - stepSize, tNext)) {
+                return y;
+            }
+        }
+    }
+    return y;
+}
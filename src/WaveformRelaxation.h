@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "ODESystemSolver.h"
+#include "ThreadPool.h"
+
+/**
+ * @brief Class for solving weakly coupled partitioned systems with waveform relaxation.
+ *
+ * The time axis is split into windows. In every window each partition is integrated as a small system of its own,
+ * with the coupling variables of the other partitions taken from their waveforms of the previous iteration (Jacobi,
+ * all partitions in parallel on a ThreadPool) or of the newest iteration (Gauss-Seidel, the partitions in order).
+ * Waveforms are stored at the steps and interpolated with cubic polynomials in between. A window is finished when
+ * the waveforms change by less than the tolerance.
+ */
+class WaveformRelaxation : public ODESystemSolver {
+
+public:
+    enum class Method {
+        Jacobi,
+        GaussSeidel
+    };
+
+    /**
+     * @brief Right hand side of one partition.
+     *
+     * @param partition  Index of the partition
+     * @param         z  Components of the partition, in their order
+     * @param  coupling  Values of the coupling variables of the partition, in the order of Partition::coupling
+     * @param         t  Time
+     * @param      dydt  Derivatives of the components of the partition, in their order
+     */
+    using PartitionFunction = std::function<void(unsigned int partition, const std::vector<double>& z,
+                                                 const std::vector<double>& coupling, double t,
+                                                 std::vector<double>& dydt)>;
+
+    /**
+     * @brief Components of y owned by a partition and components of other partitions it reads.
+     */
+    struct Partition {
+        std::vector<unsigned int> components;
+        std::vector<unsigned int> coupling;
+    };
+
+    /**
+     * @brief Construct a WaveformRelaxation object
+     *
+     * @param             f  Right hand side of the partitions
+     * @param    partitions  Partitions, every component of y belongs to exactly one
+     * @param            y0  Initial value of y
+     * @param            t0  Initial value of t
+     * @param        solver  Solver used for every partition
+     * @param   windowSteps  Number of steps per window
+     * @param        method  Jacobi or Gauss-Seidel iteration
+     * @param          pool  Thread pool for the Jacobi iteration, the partitions run serially without one
+     * @param           tol  Relative tolerance of the waveform change
+     * @param maxIterations  Maximum number of iterations per window, solve throws if a window does not converge
+     */
+    WaveformRelaxation(PartitionFunction f, std::vector<Partition> partitions, std::vector<double> y0, double t0,
+                       ODESystemSolverFactory solver, unsigned int windowSteps, Method method = Method::Jacobi,
+                       std::shared_ptr<ThreadPool> pool = nullptr, double tol = 1e-10,
+                       unsigned int maxIterations = 50);
+
+    /**
+     * @brief Solves the system of ODEs using waveform relaxation.
+     * @param stepSize The step size of the partition solvers and of the stored waveforms.
+     * @param tEnd The time to solve the ODE to.
+     * @return A vector of the solution vector at each step.
+     */
+    std::vector<std::vector<double>> solve(double stepSize, double tEnd) override;
+
+    /**
+     * @brief Number of iterations over all windows of the last solve.
+     */
+    unsigned int iterations() const { return totalIterations; }
+
+private:
+    PartitionFunction partitionFunction;
+    std::vector<Partition> partitions;
+    ODESystemSolverFactory solver;
+    unsigned int windowSteps;
+    Method method;
+    std::shared_ptr<ThreadPool> pool;
+    double tol;
+    unsigned int maxIterations;
+    // Partition and position within it of every component
+    std::vector<unsigned int> owner;
+    std::vector<unsigned int> position;
+    unsigned int totalIterations = 0;
+
+    /**
+     * @brief Integrates partition p over a window given the waveforms of the other partitions.
+     *
+     * @param    waves  waves[q][k] are the components of partition q at step k of the window
+     * @param        p  Index of the partition
+     * @param  tWindow  Start of the window
+     * @param stepSize  The step size
+     * @param    steps  Number of steps in the window
+     * @return The new waveform of partition p
+     */
+    std::vector<std::vector<double>> integrate(const std::vector<std::vector<std::vector<double>>>& waves,
+                                               unsigned int p, double tWindow, double stepSize,
+                                               unsigned int steps) const;
+};
@@ -2,6 +2,8 @@
 #include <muParser.h>
 #include <memory>
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 #include "ODESolver.h"
 #include "utilities.h"
 #include "ExplicitEuler.h"
@@ -9,6 +11,13 @@
 #include "RungeKutta.h"
 #include "Heun.h"
 #include "AdamsBashforthTwo.h"
+#include "AdditiveRungeKutta.h"
+#include "ScalarSystemSolver.h"
+#include "MethodOfLines.h"
+#include "ImplicitEulerSystem.h"
+#include "SparseLinearSolver.h"
+#include "BandedLinearSolver.h"
+#include "BulirschStoer.h"
 
 using namespace nlohmann;
 
@@ -17,6 +26,8 @@ using namespace nlohmann;
  */
 struct SolverConfiguration : public utilities::ODESpecification {
     std::unique_ptr<ODESolver> solver;
+    // Set instead of solver for systems, e.g. function_provider = MethodOfLines
+    std::unique_ptr<ODESystemSolver> systemSolver;
 };
 
 /**
@@ -30,10 +41,17 @@ struct SolverConfiguration : public utilities::ODESpecification {
      *                        function_provider = Custom: Command to execute (command line argument should be 2 doubles y and t)
      * @key df                function_provider = Default:    irrelevant
      *                        function_provider = Custom: Command to execute (command line argument should be 2 doubles y and t)
+     * @key f_explicit        solver = ARK3|ARK4 (function_provider = Custom): non-stiff part of f, treated explicitly
+     * @key f_implicit        solver = ARK3|ARK4 (function_provider = Custom): stiff part of f, df is its derivative and
+ *                        may be omitted, it is then approximated by central differences of f_implicit
+     * @key pde               function_provider = MethodOfLines: the PDE u_t = D (u_xx + u_yy) - v . grad u + R,
+     *                        see parseMethodOfLines, y0 is replaced by pde.initial
      * @key y0                Initial value of y
      * @key t0                Initial value of t
      * @key tEnd              Time to solve the ODE to
      * @key stepSize          Step size
+     * @key events            Optional list of events {"g": expression in y and t, "terminal": true|false,
+     *                        "direction": "both"|"rising"|"falling"}, located events are written to events_<name>.csv
 */
 void createDefaultConfig(const std::string &filename) {
     ordered_json config;
@@ -53,13 +71,40 @@ void createDefaultConfig(const std::string &filename) {
 }
 
 /**
- * @brief Parses the config.json file to create c++ functions for f and df.
- * @param config    The json object containing the configuration.
- * @return A pair of functions f and df.
+ * @brief Creates a c++ function from an expression in y and t parsed by muparser.
+ * @param expression    The expression.
+ * @return The function.
+*/
+std::function<double(double, double)> parseExpression(const std::string &expression) {
+    mu::Parser parser;
+    parser.SetExpr(expression);
+    return [parser](double y, double t) mutable -> double {
+        parser.DefineVar("t", &t);
+        parser.DefineVar("y", &y);
+        return parser.Eval();
+    };
+}
+
+/**
+ * @brief The right hand side of a configuration. For a split right hand side f = fExplicit + fImplicit and df is the
+ * derivative of fImplicit only, otherwise fExplicit and fImplicit are empty.
 */
-std::pair<std::function<double(double, double)>, std::function<double(double, double)>> parseFunction(json &config) {
+struct FunctionConfiguration {
     std::function<double(double, double)> f;
     std::function<double(double, double)> df;
+    std::function<double(double, double)> fExplicit;
+    std::function<double(double, double)> fImplicit;
+};
+
+/**
+ * @brief Parses the config.json file to create c++ functions for f and df, and the parts of a split f.
+ * @param config    The json object containing the configuration.
+ * @return The parsed functions, every expression is parsed once.
+*/
+FunctionConfiguration parseFunction(json &config) {
+    FunctionConfiguration functions;
+    auto& f = functions.f;
+    auto& df = functions.df;
     if (config.at("function_provider") == "Default") {
         switch (config["f"].get<int>()) {
             case 1:
@@ -74,35 +119,65 @@ std::pair<std::function<double(double, double)>, std::function<double(double, do
                 throw std::invalid_argument("Invalid function number");
         }
     } else if (config.at("function_provider") == "Custom") {
-        mu::Parser parserF;
-        parserF.SetExpr(config.at("f"));
-
-        mu::Parser parserDF;
-        parserDF.SetExpr(config.at("df"));
-
-        f = [parserF](double y, double t) mutable -> double {
-            parserF.DefineVar("t", &t);
-            parserF.DefineVar("y", &y);
-            return parserF.Eval();
-        };
-        df = [parserDF](double y, double t)  mutable -> double {
-            parserDF.DefineVar("t", &t);
-            parserDF.DefineVar("y", &y);
-            return parserDF.Eval();
-        };
+        if (!config.contains("f") && config.contains("f_explicit") && config.contains("f_implicit")) {
+            auto fExplicit = parseExpression(config.at("f_explicit"));
+            auto fImplicit = parseExpression(config.at("f_implicit"));
+            f = [fExplicit, fImplicit](double y, double t) { return fExplicit(y, t) + fImplicit(y, t); };
+            functions.fExplicit = fExplicit;
+            functions.fImplicit = fImplicit;
+            if (config.contains("df") && !config.at("df").is_null()) {
+                df = parseExpression(config.at("df"));
+            } else {
+                // Only the Newton iterations of the implicit part need df, approximate it by a central difference
+                df = [fImplicit](double y, double t) {
+                    const double h = 1e-7 * std::max(1.0, std::abs(y));
+                    return (fImplicit(y + h, t) - fImplicit(y - h, t)) / (2 * h);
+                };
+            }
+        } else {
+            f = parseExpression(config.at("f"));
+            df = parseExpression(config.at("df"));
+        }
     } else {
         throw std::invalid_argument("Invalid function_provider");
     }
-    return std::make_pair(f, df);
+    return functions;
+}
+
+/**
+ * @brief Parses the events of the config.json file, the event functions are expressions in y and t.
+ * @param config    The json object containing the configuration.
+ * @return The events.
+*/
+std::vector<Event> parseEvents(json &config) {
+    std::vector<Event> events;
+    for (json &entry: config.at("events")) {
+        auto g = parseExpression(entry.at("g"));
+        Event event;
+        event.g = [g](const std::vector<double>& y, double t) { return g(y[0], t); };
+        event.terminal = entry.value("terminal", false);
+        std::string direction = entry.value("direction", "both");
+        if (direction == "rising") {
+            event.direction = Event::Direction::Rising;
+        } else if (direction == "falling") {
+            event.direction = Event::Direction::Falling;
+        } else if (direction != "both") {
+            throw std::invalid_argument("Invalid event direction");
+        }
+        events.push_back(std::move(event));
+    }
+    return events;
 }
 
 /**
  * @brief Parses the config.json file to create a solver.
  * @param config    The json object containing the configuration.
+ * @param functions The functions parsed by parseFunction.
  * @return A pointer to the solver object.
 */
-std::unique_ptr<ODESolver>
-parseSolver(json &config, std::function<double(double, double)> f, std::function<double(double, double)> df) {
+std::unique_ptr<ODESolver> parseSolver(json &config, const FunctionConfiguration& functions) {
+    const auto& f = functions.f;
+    const auto& df = functions.df;
     std::string solverName = config["solver"];
     if (solverName == "ExplicitEuler") {
         std::unique_ptr<ODESolver> solver = make_unique<ExplicitEuler>(f, config["y0"], config["t0"]);
@@ -116,11 +191,140 @@ parseSolver(json &config, std::function<double(double, double)> f, std::function
         return make_unique<Heun>(f, config["y0"], config["t0"]);
     } else if (solverName == "AdamsBashforthTwo") {
         return make_unique<AdamsBashforthTwo>(f, config["y0"], config["t0"]);
+    } else if (solverName == "ARK3" || solverName == "ARK4") {
+        if (!functions.fExplicit || !functions.fImplicit) {
+            throw std::invalid_argument("Additive Runge-Kutta solvers need f_explicit and f_implicit");
+        }
+        auto method = solverName == "ARK3" ? AdditiveRungeKutta::Method::ARK3 : AdditiveRungeKutta::Method::ARK4;
+        DenseJacobianFunction jacobian = [df](const std::vector<double>& y, double t, std::vector<double>& J) {
+            J[0] = df(y[0], t);
+        };
+        std::unique_ptr<ODESystemSolver> system = make_unique<AdditiveRungeKutta>(
+                ScalarSystemSolver::system(functions.fExplicit),
+                ScalarSystemSolver::system(functions.fImplicit),
+                std::vector<double>{config["y0"]}, config["t0"], jacobian, method);
+        return make_unique<ScalarSystemSolver>(f, std::move(system), config["y0"], config["t0"]);
     } else {
         throw std::invalid_argument("Invalid solver name");
     }
 }
 
+/**
+ * @brief Expression parsed by muparser and evaluated in bulk mode for all grid points at once.
+ */
+struct BulkExpression {
+    mu::Parser parser;
+    std::vector<double> u, t, x, y;
+};
+
+/**
+ * @brief Creates a bulk expression in u, t, x and y for the points of a method-of-lines grid.
+ * @param expression    The expression.
+ * @param mol           The method-of-lines problem providing the grid.
+ * @return The expression, its variables u and t have to be filled before evaluation.
+*/
+std::shared_ptr<BulkExpression> parseBulkExpression(const std::string &expression, const MethodOfLines &mol) {
+    auto bulk = std::make_shared<BulkExpression>();
+    unsigned int n = mol.size();
+    bulk->u.assign(n, 0.0);
+    bulk->t.assign(n, 0.0);
+    for (unsigned int k = 0; k < n; k++) {
+        auto [x, y] = mol.point(k);
+        bulk->x.push_back(x);
+        bulk->y.push_back(y);
+    }
+    bulk->parser.DefineVar("u", bulk->u.data());
+    bulk->parser.DefineVar("t", bulk->t.data());
+    bulk->parser.DefineVar("x", bulk->x.data());
+    bulk->parser.DefineVar("y", bulk->y.data());
+    bulk->parser.SetExpr(expression);
+    return bulk;
+}
+
+/**
+ * @brief Parses the pde object of the config.json file, with the following structure:
+ *
+ * @key nx                Number of unknowns in x
+ * @key ny                Number of unknowns in y (optional, 1 for 1D problems)
+ * @key lx, ly            Lengths of the domain (optional, 1)
+ * @key boundary          "Dirichlet"/"Periodic"
+ * @key boundary_value    Value of u on a Dirichlet boundary (optional, 0)
+ * @key diffusion         Diffusion coefficient D
+ * @key velocity          Advection velocity [v_x, v_y] (optional, 0)
+ * @key reaction          Expression in u, t, x and y for R (optional)
+ * @key initial           Expression in x and y for u at t0
+ * @param pde       The json object of the PDE.
+ * @return The method-of-lines problem and the initial values at the grid points.
+*/
+std::pair<MethodOfLines, std::vector<double>> parseMethodOfLines(json &pde) {
+    MethodOfLines::Grid grid;
+    grid.nx = pde.at("nx");
+    grid.ny = pde.value("ny", 1u);
+    grid.lx = pde.value("lx", 1.0);
+    grid.ly = pde.value("ly", 1.0);
+    std::string boundary = pde.value("boundary", "Dirichlet");
+    if (boundary == "Periodic") {
+        grid.boundary = MethodOfLines::Boundary::Periodic;
+    } else if (boundary != "Dirichlet") {
+        throw std::invalid_argument("Invalid boundary");
+    }
+    grid.boundaryValue = pde.value("boundary_value", 0.0);
+    std::array<double, 2> velocity = pde.value("velocity", std::array<double, 2>{0.0, 0.0});
+    MethodOfLines geometry(grid, pde.at("diffusion"), velocity);
+
+    MethodOfLines::ReactionFunction reaction;
+    if (pde.contains("reaction")) {
+        auto bulk = parseBulkExpression(pde.at("reaction"), geometry);
+        reaction = [bulk](const std::vector<double>& u, double t, std::vector<double>& r) {
+            std::copy(u.begin(), u.end(), bulk->u.begin());
+            std::fill(bulk->t.begin(), bulk->t.end(), t);
+            bulk->parser.Eval(r.data(), static_cast<int>(r.size()));
+        };
+    }
+    auto initial = parseBulkExpression(pde.at("initial"), geometry);
+    std::vector<double> u0(geometry.size());
+    initial->parser.Eval(u0.data(), static_cast<int>(u0.size()));
+    return {MethodOfLines(grid, pde.at("diffusion"), velocity, reaction), u0};
+}
+
+/**
+ * @brief Linear solver for the Newton systems of a method-of-lines problem, banded for 1D Dirichlet grids and
+ * sparse otherwise.
+ * @param mol           The method-of-lines problem.
+ * @param diffusionOnly Whether the implicit part is the diffusion only.
+ * @return A pointer to the linear solver.
+*/
+std::unique_ptr<LinearSolver> parseLinearSolver(const MethodOfLines &mol, bool diffusionOnly) {
+    auto [kl, ku] = mol.bandwidth();
+    if (mol.isBanded() && kl <= 1) {
+        return std::make_unique<BandedLinearSolver>(mol.bandedJacobian(diffusionOnly), kl, ku);
+    }
+    return std::make_unique<SparseLinearSolver>(mol.jacobian(diffusionOnly));
+}
+
+/**
+ * @brief Parses the config.json file to create a solver for a method-of-lines problem.
+ * @param config    The json object containing the configuration.
+ * @return A pointer to the solver object.
+*/
+std::unique_ptr<ODESystemSolver> parseSystemSolver(json &config) {
+    auto [mol, u0] = parseMethodOfLines(config.at("pde"));
+    std::string solverName = config["solver"];
+    if (solverName == "ImplicitEuler") {
+        return make_unique<ImplicitEulerSystem>(mol.rhs(), u0, config["t0"],
+                                                parseLinearSolver(mol, false));
+    } else if (solverName == "ARK3" || solverName == "ARK4") {
+        // Diffusion implicit, advection and reaction explicit
+        auto method = solverName == "ARK3" ? AdditiveRungeKutta::Method::ARK3 : AdditiveRungeKutta::Method::ARK4;
+        return make_unique<AdditiveRungeKutta>(mol.transportPart(), mol.diffusionPart(), u0, config["t0"],
+                                               parseLinearSolver(mol, true), method);
+    } else if (solverName == "BulirschStoer") {
+        return make_unique<BulirschStoer>(mol.rhs(), u0, config["t0"]);
+    } else {
+        throw std::invalid_argument("Invalid solver name for function_provider MethodOfLines");
+    }
+}
+
 /**
  * @brief Parses the config.json file to create a solver configuration.
  * @param config    The json object containing the configuration.
@@ -134,20 +338,37 @@ SolverConfiguration parseFile(const std::string& filename) {
     json rawJSON;
     file >> rawJSON;
 
-    auto [f, df] = parseFunction(rawJSON);
+    if (rawJSON.at("function_provider") == "MethodOfLines") {
+        if (rawJSON.contains("events")) {
+            throw std::invalid_argument("Events are only supported for scalar ODEs");
+        }
+        SolverConfiguration config;
+        config.name = rawJSON["name"];
+        config.t0 = rawJSON["t0"];
+        config.tEnd = rawJSON["tEnd"];
+        config.stepSize = rawJSON["stepSize"];
+        config.systemSolver = parseSystemSolver(rawJSON);
+        return config;
+    }
+
+    FunctionConfiguration functions = parseFunction(rawJSON);
 
     SolverConfiguration config = {
             {
                     rawJSON["name"],
-                    f,
-                    df,
+                    functions.f,
+                    functions.df,
                     rawJSON["y0"],
                     rawJSON["t0"],
                     rawJSON["tEnd"],
                     rawJSON["stepSize"]
             },
-            parseSolver(rawJSON, f, df)
+            parseSolver(rawJSON, functions),
+            nullptr
     };
+    if (rawJSON.contains("events")) {
+        config.solver->setEvents(parseEvents(rawJSON));
+    }
     return config;
 }
 
@@ -178,5 +399,13 @@ int main(int argc, char **argv) {
         return 1;
     }
 
+    if (config.systemSolver) {
+        utilities::writeSolution("results_" + config.name, config.t0, config.stepSize,
+                                 config.systemSolver->solve(config.stepSize, config.tEnd));
+        return 0;
+    }
     utilities::writeSolution("results_" + config.name, config.t0, config.stepSize, config.solver->solve(config.stepSize, config.tEnd));
+    if (!config.solver->eventLog().empty()) {
+        utilities::writeEvents("events_" + config.name, config.solver->eventLog());
+    }
 }
\ No newline at end of file
@@ -12,6 +12,45 @@ namespace utilities {
         file.close();
     }
 
+    void writeSolution(const std::string& filename, double t0, double stepSize,
+                       const std::vector<std::vector<double>>& y) {
+        std::ofstream file;
+        file.open(filename + ".csv");
+        file << "t";
+        for (unsigned int i = 0; i < (y.empty() ? 0 : y.front().size()); i++) {
+            file << ",y" << i;
+        }
+        file << "\n";
+        double t = t0;
+        for (const std::vector<double>& y_n: y) {
+            file << t;
+            for (double y_i: y_n) {
+                file << "," << y_i;
+            }
+            file << "\n";
+            t = t + stepSize;
+        }
+        file.close();
+    }
+
+    void writeEvents(const std::string& filename, const std::vector<EventRecord>& events) {
+        std::ofstream file;
+        file.open(filename + ".csv");
+        file << "event,t";
+        for (unsigned int i = 0; i < (events.empty() ? 0 : events.front().y.size()); i++) {
+            file << ",y" << i;
+        }
+        file << "\n";
+        for (const EventRecord& event: events) {
+            file << event.event << "," << event.t;
+            for (double y_i: event.y) {
+                file << "," << y_i;
+            }
+            file << "\n";
+        }
+        file.close();
+    }
+
     double calculateRMSE(const std::vector<double> &yNumerical, const std::vector<double> &yAnalytical) {
         double SumSquaredDifferences = 0.0;
         for (auto i = 0; i < yNumerical.size(); i++) {
@@ -20,4 +59,15 @@ namespace utilities {
         }
         return sqrt(SumSquaredDifferences / yNumerical.size());
     }
+
+    std::vector<double> extrapolationWeights(unsigned int k) {
+        // w[j-1] = (-1)^(j+1) * binomial(k, j)
+        std::vector<double> weights(k);
+        double binomial = 1.0;
+        for (unsigned int j = 1; j <= k; j++) {
+            binomial = binomial * (k - j + 1) / j;
+            weights[j - 1] = j % 2 == 1 ? binomial : -binomial;
+        }
+        return weights;
+    }
 }
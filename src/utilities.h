@@ -7,6 +7,7 @@
 #include <cmath>
 #include <array>
 #include <memory>
+#include "EventDetector.h"
 
 
 /**
@@ -46,6 +47,25 @@ namespace utilities {
     */
     void writeSolution(const std::string& filename, double t0, double stepSize, const std::vector<double>& y);
 
+    /**
+    * @brief Writes the solution of a system to a csv, one column per component.
+    *
+    * @param filename   Name of the file to write to
+    * @param t0         Initial value of t
+    * @param stepSize   Step size
+    * @param y          Solution vectors
+    */
+    void writeSolution(const std::string& filename, double t0, double stepSize,
+                       const std::vector<std::vector<double>>& y);
+
+    /**
+    * @brief Writes located events to a csv, one row per event with its index, time and solution.
+    *
+    * @param filename   Name of the file to write to
+    * @param events     The events
+    */
+    void writeEvents(const std::string& filename, const std::vector<EventRecord>& events);
+
     /**
     * @brief Calculates the Root Mean Squared Error between the solution and the analytical solution.
     *
@@ -53,6 +73,14 @@ namespace utilities {
     * @param yAnalytical Exact, analytical solution
     */
     double calculateRMSE(const std::vector<double> &yNumerical, const std::vector<double> &yAnalytical);
+
+    /**
+    * @brief Weights of the polynomial extrapolation through k equidistant values to the next grid point.
+    *
+    * @param k  Number of past values
+    * @return Weights w such that y_{n+1} ~ w[0] * y_n + w[1] * y_{n-1} + ... + w[k-1] * y_{n-k+1}
+    */
+    std::vector<double> extrapolationWeights(unsigned int k);
 }
 
 
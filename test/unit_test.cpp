@@ -6,6 +6,36 @@
 #include "../src/utilities.h"
 #include "../src/Heun.h"
 #include "../src/AdamsBashforthTwo.h"
+#include "../src/SparseMatrix.h"
+#include "../src/SparseLU.h"
+#include "../src/DenseLU.h"
+#include "../src/SparseLinearSolver.h"
+#include "../src/ImplicitEulerSystem.h"
+#include "../src/JacobianFreeLinearSolver.h"
+#include "../src/GMRES.h"
+#include "../src/ILU0.h"
+#include "../src/ILUPreconditioner.h"
+#include "../src/BlockJacobiPreconditioner.h"
+#include "../src/Symplectic.h"
+#include "../src/ETDRK4.h"
+#include "../src/AdditiveRungeKutta.h"
+#include "../src/MultirateRungeKutta.h"
+#include "../src/ThreadPool.h"
+#include "../src/BulirschStoer.h"
+#include "../src/Parareal.h"
+#include "../src/RIDC.h"
+#include "../src/WaveformRelaxation.h"
+#include "../src/MethodOfLines.h"
+#include "../src/BandedLU.h"
+#include "../src/BandedLinearSolver.h"
+#include "../src/DelayRungeKutta.h"
+#include "../src/SDESolver.h"
+#include "../src/MultilevelMonteCarlo.h"
+#include "../src/RungeKuttaNystrom.h"
+#include "../src/MultipleShooting.h"
+#include "../src/AdjointImplicitEuler.h"
+#include "../src/DenseOutput.h"
+#include "../src/ScalarSystemSolver.h"
 
 using namespace testing;
 
@@ -85,7 +115,1515 @@ TEST(ODESolvers, AdamsBashforthTwo) {
     }
 }
 
-int main() {
+/**
+ * @brief Newton matrix I - gamma * J of the 2D five point Laplacian on an m x m grid.
+ */
+CSRMatrix laplacianNewtonMatrix(unsigned int m, double gamma) {
+    std::vector<Triplet> triplets;
+    for (unsigned int i = 0; i < m; i++) {
+        for (unsigned int j = 0; j < m; j++) {
+            unsigned int k = i * m + j;
+            triplets.push_back({k, k, 1 + 4 * gamma});
+            if (i > 0) triplets.push_back({k, k - m, -gamma});
+            if (i + 1 < m) triplets.push_back({k, k + m, -gamma});
+            if (j > 0) triplets.push_back({k, k - 1, -gamma});
+            if (j + 1 < m) triplets.push_back({k, k + 1, -gamma});
+        }
+    }
+    return CSRMatrix::fromTriplets(m * m, m * m, triplets);
+}
+
+TEST(LinearAlgebra, SparseMatrixConversion) {
+    CSRMatrix A = CSRMatrix::fromTriplets(3, 3, {{2, 0, 1.0}, {0, 1, 2.0}, {0, 1, 1.0}, {1, 2, -4.0}, {2, 2, 5.0}});
+    EXPECT_EQ(A.nonZeros(), 4);
+    EXPECT_EQ(A.values[A.find(0, 1)], 3.0);
+    EXPECT_EQ(A.find(1, 1), -1);
+    CSRMatrix B = A.toCSC().toCSR();
+    EXPECT_EQ(A.rowPtr, B.rowPtr);
+    EXPECT_EQ(A.colIdx, B.colIdx);
+    EXPECT_EQ(A.values, B.values);
+    std::vector<double> x{1, 2, 3}, yCSR, yCSC;
+    A.multiply(x, yCSR);
+    A.toCSC().multiply(x, yCSC);
+    EXPECT_EQ(yCSR, yCSC);
+}
+
+TEST(LinearAlgebra, SparseLU) {
+    const unsigned int m = 30;
+    CSRMatrix A = laplacianNewtonMatrix(m, 0.5);
+    std::vector<double> x(A.rows), b;
+    for (unsigned int i = 0; i < A.rows; i++) {
+        x[i] = sin(i);
+    }
+    A.multiply(x, b);
+
+    SparseLU natural(SparseLU::Ordering::Natural);
+    SparseLU minimumDegree(SparseLU::Ordering::MinimumDegree);
+    for (SparseLU* lu: {&natural, &minimumDegree}) {
+        lu->factorize(A);
+        std::vector<double> solution(b);
+        lu->solve(solution);
+        EXPECT_LE(utilities::calculateRMSE(solution, x), 1e-12);
+    }
+    std::cout << "SparseLU fill: natural " << natural.factorNonZeros() << ", minimum degree "
+              << minimumDegree.factorNonZeros() << std::endl;
+    EXPECT_LT(minimumDegree.factorNonZeros(), natural.factorNonZeros());
+
+    // Zero diagonal, the rows are matched to a zero-free diagonal before the ordering
+    CSRMatrix swap = CSRMatrix::fromTriplets(3, 3, {{0, 1, 2.0}, {1, 0, 1.0}, {1, 1, 3.0}, {2, 2, 4.0}});
+    std::vector<double> swapSolution = {4.0, 8.0, 8.0};
+    natural.factorize(swap);
+    natural.solve(swapSolution);
+    EXPECT_LE(utilities::calculateRMSE(swapSolution, {2.0, 2.0, 2.0}), 1e-15);
+    EXPECT_EQ(natural.rowMatching(), std::vector<unsigned int>({1, 0, 2}));
+
+    // Numeric refactorization with the same pattern reuses the analysis
+    A = laplacianNewtonMatrix(m, 2.0);
+    EXPECT_TRUE(minimumDegree.hasPattern(A));
+    minimumDegree.factorize(A);
+    A.multiply(x, b);
+    minimumDegree.solve(b);
+    EXPECT_LE(utilities::calculateRMSE(b, x), 1e-12);
+}
+
+TEST(LinearAlgebra, DenseLU) {
+    for (unsigned int n: {5, 32, 100}) {
+        // Zero diagonal forces pivoting
+        std::vector<double> A(n * n), x(n), b(n, 0.0);
+        for (unsigned int i = 0; i < n; i++) {
+            x[i] = cos(i);
+            for (unsigned int j = 0; j < n; j++) {
+                A[i * n + j] = i == j ? 0.0 : sin(i * n + j + 1.0);
+            }
+        }
+        for (unsigned int i = 0; i < n; i++) {
+            for (unsigned int j = 0; j < n; j++) {
+                b[i] += A[i * n + j] * x[j];
+            }
+        }
+        DenseLU lu;
+        lu.factorize(A, n);
+        // Batch of multiples of b, stored row-major
+        std::vector<double> B(3 * n);
+        for (unsigned int i = 0; i < n; i++) {
+            for (unsigned int j = 0; j < 3; j++) {
+                B[i * 3 + j] = (j + 1) * b[i];
+            }
+        }
+        lu.solve(b);
+        EXPECT_LE(utilities::calculateRMSE(b, x), 1e-10) << n;
+        lu.solve(B, 3);
+        for (unsigned int i = 0; i < n; i++) {
+            EXPECT_NEAR(B[i * 3 + 2], 3 * b[i], 1e-10) << n;
+        }
+    }
+    DenseLU lu;
+    EXPECT_THROW(lu.factorize(std::vector<double>(4, 1.0), 2), std::runtime_error);
+}
+
+TEST(ODESystemSolvers, ImplicitEulerSystem) {
+    // y' = A y with A = [[-2, 1], [1, -2]], y(0) = (2, 0)
+    SystemFunction f = [](const std::vector<double>& y, double t, std::vector<double>& dydt) {
+        dydt[0] = -2 * y[0] + y[1];
+        dydt[1] = y[0] - 2 * y[1];
+    };
+    DenseJacobianFunction jacobian = [](const std::vector<double>& y, double t, std::vector<double>& J) {
+        J = {-2, 1, 1, -2};
+    };
+    ImplicitEulerSystem solver(f, {2.0, 0.0}, 0.0, jacobian);
+    const double stepSize = 1e-4;
+    std::vector<std::vector<double>> yNumerical = solver.solve(stepSize, 2.0);
+    std::vector<double> first, second, firstExact, secondExact;
+    for (unsigned int n = 0; n < yNumerical.size(); n++) {
+        double t = n * stepSize;
+        first.push_back(yNumerical[n][0]);
+        second.push_back(yNumerical[n][1]);
+        firstExact.push_back(exp(-t) + exp(-3 * t));
+        secondExact.push_back(exp(-t) - exp(-3 * t));
+    }
+    EXPECT_EQ(yNumerical.size(), 20001);
+    EXPECT_LE(utilities::calculateRMSE(first, firstExact), 1e-3);
+    EXPECT_LE(utilities::calculateRMSE(second, secondExact), 1e-3);
+}
+
+/**
+ * @brief Stiff nonlinear reaction-diffusion chain y_i' = 1000 (y_{i-1} - 2 y_i + y_{i+1}) - y_i^3 with n = 200.
+ */
+namespace stiffChain {
+    const unsigned int n = 200;
+
+    void f(const std::vector<double>& y, double t, std::vector<double>& dydt) {
+        for (unsigned int i = 0; i < n; i++) {
+            double left = i > 0 ? y[i - 1] : 0.0;
+            double right = i + 1 < n ? y[i + 1] : 0.0;
+            dydt[i] = 1000 * (left - 2 * y[i] + right) - y[i] * y[i] * y[i];
+        }
+    }
+
+    void denseJacobian(const std::vector<double>& y, double t, std::vector<double>& J) {
+        for (unsigned int i = 0; i < n; i++) {
+            J[i * n + i] = -2000 - 3 * y[i] * y[i];
+            if (i > 0) J[i * n + i - 1] = 1000;
+            if (i + 1 < n) J[i * n + i + 1] = 1000;
+        }
+    }
+
+    void sparseJacobian(const std::vector<double>& y, double t, CSRMatrix& J) {
+        std::vector<Triplet> triplets;
+        for (unsigned int i = 0; i < n; i++) {
+            triplets.push_back({i, i, -2000 - 3 * y[i] * y[i]});
+            if (i > 0) triplets.push_back({i, i - 1, 1000});
+            if (i + 1 < n) triplets.push_back({i, i + 1, 1000});
+        }
+        J = CSRMatrix::fromTriplets(n, n, triplets);
+    }
+
+    void bandedJacobian(const std::vector<double>& y, double t, BandedMatrix& J) {
+        for (unsigned int i = 0; i < n; i++) {
+            J(i, i) = -2000 - 3 * y[i] * y[i];
+            if (i > 0) J(i, i - 1) = 1000;
+            if (i + 1 < n) J(i, i + 1) = 1000;
+        }
+    }
+
+    std::vector<double> y0() {
+        std::vector<double> y(n);
+        for (unsigned int i = 0; i < n; i++) {
+            y[i] = sin(M_PI * (i + 1) / (n + 1));
+        }
+        return y;
+    }
+}
+
+TEST(ODESystemSolvers, ImplicitEulerSystemSparse) {
+    ImplicitEulerSystem dense(stiffChain::f, stiffChain::y0(), 0.0, stiffChain::denseJacobian);
+    ImplicitEulerSystem sparse(stiffChain::f, stiffChain::y0(), 0.0,
+                               std::make_unique<SparseLinearSolver>(stiffChain::sparseJacobian));
+    std::vector<std::vector<double>> yDense = dense.solve(1e-2, 1.0);
+    std::vector<std::vector<double>> ySparse = sparse.solve(1e-2, 1.0);
+    ASSERT_EQ(yDense.size(), 101);
+    ASSERT_EQ(ySparse.size(), 101);
+    EXPECT_LE(utilities::calculateRMSE(ySparse.back(), yDense.back()), 1e-7);
+}
+
+TEST(ODESystemSolvers, ImplicitEulerSystemJacobianFree) {
+    ImplicitEulerSystem dense(stiffChain::f, stiffChain::y0(), 0.0, stiffChain::denseJacobian);
+    auto jfnk = std::make_unique<JacobianFreeLinearSolver>(stiffChain::f);
+    JacobianFreeLinearSolver& linearSolver = *jfnk;
+    ImplicitEulerSystem jacobianFree(stiffChain::f, stiffChain::y0(), 0.0, std::move(jfnk));
+    std::vector<std::vector<double>> yDense = dense.solve(1e-2, 1.0);
+    std::vector<std::vector<double>> yJacobianFree = jacobianFree.solve(1e-2, 1.0);
+    ASSERT_EQ(yJacobianFree.size(), 101);
+    EXPECT_LE(utilities::calculateRMSE(yJacobianFree.back(), yDense.back()), 1e-6);
+    const auto& stats = linearSolver.statistics();
+    std::cout << "JFNK: " << stats.linearSolves << " linear solves, " << stats.krylovIters << " GMRES iterations, "
+              << stats.rhsEvaluations << " RHS evaluations" << std::endl;
+    EXPECT_EQ(stats.failures, 0);
+}
+
+TEST(ODESystemSolvers, ImplicitEulerSystemPreconditioned) {
+    ImplicitEulerSystem dense(stiffChain::f, stiffChain::y0(), 0.0, stiffChain::denseJacobian);
+    std::vector<double> yReference = dense.solve(1e-2, 1.0).back();
+
+    std::vector<std::pair<std::string, std::unique_ptr<Preconditioner>>> preconditioners;
+    preconditioners.emplace_back("none", nullptr);
+    preconditioners.emplace_back("ILU(0)", std::make_unique<ILUPreconditioner>(stiffChain::sparseJacobian));
+    preconditioners.emplace_back("block-Jacobi",
+                                 std::make_unique<BlockJacobiPreconditioner>(stiffChain::sparseJacobian, 20));
+    unsigned long unpreconditionedIters = 0;
+    for (auto& [name, preconditioner]: preconditioners) {
+        bool isPreconditioned = preconditioner != nullptr;
+        auto jfnk = std::make_unique<JacobianFreeLinearSolver>(stiffChain::f, std::move(preconditioner));
+        JacobianFreeLinearSolver& linearSolver = *jfnk;
+        ImplicitEulerSystem solver(stiffChain::f, stiffChain::y0(), 0.0, std::move(jfnk));
+        EXPECT_LE(utilities::calculateRMSE(solver.solve(1e-2, 1.0).back(), yReference), 1e-6) << name;
+        const auto& stats = linearSolver.statistics();
+        std::cout << "JFNK with " << name << ": " << stats.krylovIters << " GMRES iterations in "
+                  << stats.linearSolves << " solves, " << stats.preconditionerSetups << " setups ("
+                  << stats.preconditionerSetupTime << " s), " << stats.preconditionerApplies << " applies ("
+                  << stats.preconditionerApplyTime << " s)" << std::endl;
+        EXPECT_EQ(stats.failures, 0) << name;
+        if (!isPreconditioned) {
+            unpreconditionedIters = stats.krylovIters;
+        } else {
+            EXPECT_LT(2 * stats.krylovIters, unpreconditionedIters) << name;
+            EXPECT_LT(10 * stats.preconditionerSetups, stats.linearSolves) << name;
+        }
+    }
+}
+
+TEST(ODESolvers, ImplicitEulerPredictor) {
+    // Stiff and smooth: y' = -50 (y - cos(t)) - y^3
+    auto f = [](double y, double t) { return -50 * (y - cos(t)) - y * y * y; };
+    auto df = [](double y, double t) { return -50 - 3 * y * y; };
+    std::vector<double> averages;
+    std::vector<std::vector<double>> solutions;
+    for (unsigned int k: {1, 2, 3}) {
+        ImplicitEuler solver(f, 0.0, 0.0, df);
+        solver.setPredictorOrder(k);
+        solutions.push_back(solver.solve(1e-2, 10.0));
+        averages.push_back(solver.averageNewtonIterations());
+        std::cout << "Predictor order " << k << ": " << averages.back() << " Newton iterations per step" << std::endl;
+    }
+    EXPECT_LE(utilities::calculateRMSE(solutions[2], solutions[0]), 1e-8);
+    EXPECT_LE(averages[2], 0.6 * averages[0]);
+}
+
+TEST(ODESystemSolvers, ImplicitEulerSystemPredictor) {
+    std::vector<double> averages;
+    std::vector<std::vector<double>> solutions;
+    for (unsigned int k: {1, 3}) {
+        ImplicitEulerSystem solver(stiffChain::f, stiffChain::y0(), 0.0, stiffChain::denseJacobian);
+        solver.setPredictorOrder(k);
+        solutions.push_back(solver.solve(1e-2, 1.0).back());
+        averages.push_back(solver.averageNewtonIterations());
+        std::cout << "Predictor order " << k << ": " << averages.back() << " Newton iterations per step" << std::endl;
+    }
+    EXPECT_LE(utilities::calculateRMSE(solutions[1], solutions[0]), 1e-7);
+    EXPECT_LT(averages[1], averages[0]);
+}
+
+TEST(SecondOrderSolvers, SymplecticOrder) {
+    // Harmonic oscillator q'' = -q with q(0) = 1, v(0) = 0
+    AccelerationFunction a = [](const std::vector<double>& q, double t, std::vector<double>& acc) { acc[0] = -q[0]; };
+    for (auto method: {Symplectic::Method::StormerVerlet, Symplectic::Method::Yoshida4, Symplectic::Method::Yoshida6,
+                       Symplectic::Method::Yoshida8}) {
+        std::vector<double> errors;
+        unsigned int order = 0;
+        for (double stepSize: {0.2, 0.1}) {
+            Symplectic solver(a, {1.0}, {0.0}, 0.0, method);
+            order = solver.order();
+            errors.push_back(std::abs(solver.solve(stepSize, 10.0).q.back()[0] - cos(10.0)));
+        }
+        EXPECT_NEAR(log2(errors[0] / errors[1]), order, 0.3) << order;
+    }
+}
+
+TEST(SecondOrderSolvers, SymplecticEnergy) {
+    // Kepler problem with eccentricity 0.6 over 1000 orbits: the energy error stays bounded
+    AccelerationFunction a = [](const std::vector<double>& q, double t, std::vector<double>& acc) {
+        double r3 = pow(q[0] * q[0] + q[1] * q[1], 1.5);
+        acc[0] = -q[0] / r3;
+        acc[1] = -q[1] / r3;
+    };
+    auto energy = [](const std::vector<double>& q, const std::vector<double>& v) {
+        return (v[0] * v[0] + v[1] * v[1]) / 2 - 1 / sqrt(q[0] * q[0] + q[1] * q[1]);
+    };
+    const double e = 0.6;
+    std::vector<double> q{1 - e, 0.0};
+    std::vector<double> v{0.0, sqrt((1 + e) / (1 - e))};
+    const double energy0 = energy(q, v);
+    Symplectic solver(a, q, v, 0.0, Symplectic::Method::Yoshida4);
+    const double stepSize = 2 * M_PI / 200;
+    double maxErrorFirst = 0.0;
+    double maxErrorLast = 0.0;
+    for (unsigned int orbit = 0; orbit < 1000; orbit++) {
+        solver.advance(q, v, orbit * 2 * M_PI, stepSize, 200);
+        double& maxError = orbit < 500 ? maxErrorFirst : maxErrorLast;
+        maxError = std::max(maxError, std::abs(energy(q, v) - energy0));
+    }
+    std::cout << "Yoshida4 Kepler energy error: " << maxErrorFirst << " / " << maxErrorLast << std::endl;
+    EXPECT_LE(maxErrorLast, 1e-3);
+    EXPECT_LE(maxErrorLast, 2 * maxErrorFirst);
+}
+
+TEST(ODESystemSolvers, ETDRK4) {
+    // Stiff y' = L y + R (cos t, cos t) with L = R diag(-1000, -10) R^T, solved exactly in z = R^T y
+    const double theta = 0.3;
+    const std::vector<double> lambda{1000, 10};
+    const std::vector<double> R{cos(theta), -sin(theta), sin(theta), cos(theta)};
+    std::vector<double> L(4, 0.0);
+    for (unsigned int i = 0; i < 2; i++) {
+        for (unsigned int j = 0; j < 2; j++) {
+            for (unsigned int k = 0; k < 2; k++) {
+                L[i * 2 + j] -= R[i * 2 + k] * lambda[k] * R[j * 2 + k];
+            }
+        }
+    }
+    SystemFunction forcing = [R](const std::vector<double>& y, double t, std::vector<double>& N) {
+        N[0] = (R[0] + R[1]) * cos(t);
+        N[1] = (R[2] + R[3]) * cos(t);
+    };
+    auto z = [lambda](unsigned int i, double t) {
+        double l = lambda[i];
+        return (1 - l / (l * l + 1)) * exp(-l * t) + (l * cos(t) + sin(t)) / (l * l + 1);
+    };
+    const double stepSize = 0.05;
+    ETDRK4 dense(L, forcing, {R[0] + R[1], R[2] + R[3]}, 0.0);
+    std::vector<std::vector<double>> yDense = dense.solve(stepSize, 2.0);
+    SystemFunction diagonalForcing = [](const std::vector<double>& y, double t, std::vector<double>& N) {
+        N[0] = N[1] = cos(t);
+    };
+    ETDRK4 diagonal = ETDRK4::diagonal({-lambda[0], -lambda[1]}, diagonalForcing, {1.0, 1.0}, 0.0);
+    std::vector<std::vector<double>> zDiagonal = diagonal.solve(stepSize, 2.0);
+    ASSERT_EQ(yDense.size(), 41);
+    double maxErrorDense = 0.0;
+    double maxErrorDiagonal = 0.0;
+    for (unsigned int n = 0; n < yDense.size(); n++) {
+        double t = n * stepSize;
+        double y0 = R[0] * z(0, t) + R[1] * z(1, t);
+        double y1 = R[2] * z(0, t) + R[3] * z(1, t);
+        maxErrorDense = std::max({maxErrorDense, std::abs(yDense[n][0] - y0), std::abs(yDense[n][1] - y1)});
+        maxErrorDiagonal = std::max({maxErrorDiagonal, std::abs(zDiagonal[n][0] - z(0, t)),
+                                     std::abs(zDiagonal[n][1] - z(1, t))});
+    }
+    EXPECT_LE(maxErrorDense, 1e-6);
+    EXPECT_LE(maxErrorDiagonal, 1e-6);
+
+    // Fourth order convergence on a nonlinear problem y' = -50 y + cos(t) y^2
+    SystemFunction nonlinear = [](const std::vector<double>& y, double t, std::vector<double>& N) {
+        N[0] = cos(t) * y[0] * y[0];
+    };
+    double reference = ETDRK4::diagonal({-50}, nonlinear, {1.0}, 0.0).solve(0.2 / 64, 2.0).back()[0];
+    std::vector<double> errors;
+    for (double h: {0.2, 0.1}) {
+        errors.push_back(std::abs(ETDRK4::diagonal({-50}, nonlinear, {1.0}, 0.0).solve(h, 2.0).back()[0] - reference));
+    }
+    EXPECT_GE(log2(errors[0] / errors[1]), 3.5);
+}
+
+TEST(ODESystemSolvers, AdditiveRungeKutta) {
+    // Prothero-Robinson y' = -lambda (y - sin t) + cos t with the stiff relaxation implicit, exact y = sin t
+    const double lambda = 1e4;
+    SystemFunction relaxation = [lambda](const std::vector<double>& y, double t, std::vector<double>& dydt) {
+        dydt[0] = -lambda * (y[0] - sin(t));
+    };
+    SystemFunction forcing = [](const std::vector<double>& y, double t, std::vector<double>& dydt) {
+        dydt[0] = cos(t);
+    };
+    DenseJacobianFunction relaxationJacobian = [lambda](const std::vector<double>& y, double t,
+                                                        std::vector<double>& J) {
+        J[0] = -lambda;
+    };
+    for (auto method: {AdditiveRungeKutta::Method::ARK3, AdditiveRungeKutta::Method::ARK4}) {
+        AdditiveRungeKutta solver(forcing, relaxation, {0.0}, 0.0, relaxationJacobian, method);
+        std::vector<std::vector<double>> y = solver.solve(0.1, 2.0);
+        ASSERT_EQ(y.size(), 21);
+        double maxError = 0.0;
+        for (unsigned int n = 0; n < y.size(); n++) {
+            maxError = std::max(maxError, std::abs(y[n][0] - sin(n * 0.1)));
+        }
+        // Stable although h lambda = 1000, accuracy in the stiff limit is limited by the stage order 2
+        EXPECT_LE(maxError, 1e-2);
+        // The implicit part is linear, Newton converges in one correction
+        EXPECT_LE(solver.averageNewtonIterations(), 2.0);
+    }
+
+    // Convergence order on y' = -5 y + cos(t) y^2 with the nonlinear term explicit
+    SystemFunction decay = [](const std::vector<double>& y, double t, std::vector<double>& dydt) {
+        dydt[0] = -5 * y[0];
+    };
+    SystemFunction nonlinear = [](const std::vector<double>& y, double t, std::vector<double>& dydt) {
+        dydt[0] = cos(t) * y[0] * y[0];
+    };
+    DenseJacobianFunction decayJacobian = [](const std::vector<double>& y, double t, std::vector<double>& J) {
+        J[0] = -5;
+    };
+    double reference = AdditiveRungeKutta(nonlinear, decay, {1.0}, 0.0, decayJacobian).solve(0.1 / 64, 2.0).back()[0];
+    for (auto [method, order]: {std::make_pair(AdditiveRungeKutta::Method::ARK3, 3.0),
+                                std::make_pair(AdditiveRungeKutta::Method::ARK4, 4.0)}) {
+        std::vector<double> errors;
+        for (double h: {0.1, 0.05}) {
+            AdditiveRungeKutta solver(nonlinear, decay, {1.0}, 0.0, decayJacobian, method);
+            errors.push_back(std::abs(solver.solve(h, 2.0).back()[0] - reference));
+        }
+        std::cout << "ARK error ratio " << errors[0] / errors[1] << std::endl;
+        EXPECT_GE(log2(errors[0] / errors[1]), order - 0.5);
+    }
+}
+
+TEST(ODESystemSolvers, MultirateRungeKutta) {
+    // Slow decays s_i' = -a_i s_i driving one fast component f' = -50 (f - s_0), stored last
+    const unsigned int nSlow = 20;
+    SystemFunction slow = [](const std::vector<double>& y, double t, std::vector<double>& dSlow) {
+        for (unsigned int i = 0; i < dSlow.size(); i++) {
+            dSlow[i] = -(1.0 + i) / nSlow * y[i];
+        }
+    };
+    SystemFunction fast = [](const std::vector<double>& y, double t, std::vector<double>& dFast) {
+        dFast[0] = -50 * (y[nSlow] - y[0]);
+    };
+    std::vector<double> y0(nSlow + 1, 1.0);
+    y0[nSlow] = 0.0;
+    const double a = 1.0 / nSlow;
+    auto exactFast = [a](double t) { return 50 / (50 - a) * (exp(-a * t) - exp(-50 * t)); };
+    MultirateRungeKutta solver(slow, fast, {nSlow}, y0, 0.0, 20);
+    std::vector<std::vector<double>> y = solver.solve(0.05, 2.0);
+    ASSERT_EQ(y.size(), 41);
+    double maxError = 0.0;
+    for (unsigned int n = 0; n < y.size(); n++) {
+        double t = n * 0.05;
+        maxError = std::max(maxError, std::abs(y[n][nSlow] - exactFast(t)));
+        for (unsigned int i = 0; i < nSlow; i++) {
+            maxError = std::max(maxError, std::abs(y[n][i] - exp(-(1.0 + i) / nSlow * t)));
+        }
+    }
+    EXPECT_LE(maxError, 1e-6);
+    // The slow right hand side is evaluated once per macro stage, the fast one once per micro stage
+    auto [slowEvaluations, fastEvaluations] = solver.evaluations();
+    EXPECT_EQ(slowEvaluations, 4 * 40);
+    EXPECT_EQ(fastEvaluations, 4 * 40 * 20);
+
+    // Two-way coupling
+    SystemFunction coupledSlow = [](const std::vector<double>& y, double t, std::vector<double>& dSlow) {
+        for (unsigned int i = 0; i < dSlow.size(); i++) {
+            dSlow[i] = -(1.0 + i) / nSlow * y[i] + 0.5 * sin(y[nSlow]);
+        }
+    };
+    double reference = MultirateRungeKutta(coupledSlow, fast, {nSlow}, y0, 0.0, 20).solve(0.1 / 32, 2.0).back()[0];
+    std::vector<double> errors;
+    for (double H: {0.1, 0.05}) {
+        MultirateRungeKutta coupled(coupledSlow, fast, {nSlow}, y0, 0.0, 20);
+        errors.push_back(std::abs(coupled.solve(H, 2.0).back()[0] - reference));
+    }
+    std::cout << "Multirate error ratio " << errors[0] / errors[1] << std::endl;
+    EXPECT_GE(log2(errors[0] / errors[1]), 2.5);
+}
+
+TEST(ODESystemSolvers, BulirschStoer) {
+    // Harmonic oscillator and y' = -2 t y^2 with exact solutions cos t, -sin t and 1 / (1 + t^2)
+    SystemFunction f = [](const std::vector<double>& y, double t, std::vector<double>& dydt) {
+        dydt[0] = y[1];
+        dydt[1] = -y[0];
+        dydt[2] = -2 * t * y[2] * y[2];
+    };
+    BulirschStoer serial(f, {1.0, 0.0, 1.0}, 0.0, 1e-10);
+    std::vector<std::vector<double>> y = serial.solve(0.5, 10.0);
+    ASSERT_EQ(y.size(), 21);
+    double maxError = 0.0;
+    for (unsigned int n = 0; n < y.size(); n++) {
+        double t = n * 0.5;
+        maxError = std::max({maxError, std::abs(y[n][0] - cos(t)), std::abs(y[n][1] + sin(t)),
+                             std::abs(y[n][2] - 1 / (1 + t * t))});
+    }
+    EXPECT_LE(maxError, 1e-8);
+    const BulirschStoer::Statistics& stats = serial.statistics();
+    std::cout << "Bulirsch-Stoer: " << stats.acceptedSteps << " accepted, " << stats.rejectedSteps << " rejected, "
+              << stats.evaluations << " evaluations" << std::endl;
+    // Large steps, far fewer evaluations than a fourth order method at this accuracy
+    EXPECT_LE(stats.evaluations, 2000);
+
+    // The parallel sub-integrations give the same result
+    BulirschStoer parallel(f, {1.0, 0.0, 1.0}, 0.0, 1e-10, 10, std::make_shared<ThreadPool>(4));
+    EXPECT_EQ(parallel.solve(0.5, 10.0), y);
+    EXPECT_EQ(parallel.statistics().evaluations, stats.evaluations);
+}
+
+TEST(Parallel, ThreadPool) {
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4);
+    std::vector<std::future<long>> results;
+    for (long i = 0; i < 100; i++) {
+        results.push_back(pool.submit([i]() { return i * i; }));
+    }
+    long sum = 0;
+    for (std::future<long>& result: results) {
+        sum += result.get();
+    }
+    EXPECT_EQ(sum, 328350);
+    std::future<void> failing = pool.submit([]() { throw std::runtime_error("task failed"); });
+    EXPECT_THROW(failing.get(), std::runtime_error);
+}
+
+TEST(ODESolvers, Parareal) {
+    // y' = cos(t) y with exact solution exp(sin t)
+    auto f = [](double y, double t) { return cos(t) * y; };
+    const double stepSize = 0.001;
+    std::vector<double> serial = RungeKutta(f, 1.0, 0.0).solve(stepSize, 10.0);
+    Parareal parareal(f, 1.0, 0.0, 8, std::make_shared<ThreadPool>(4), 0.1, makeFactory<RungeKutta>());
+    std::vector<double> y = parareal.solve(stepSize, 10.0);
+    ASSERT_EQ(y.size(), serial.size());
+    double maxDifference = 0.0;
+    for (unsigned int n = 0; n < y.size(); n++) {
+        maxDifference = std::max(maxDifference, std::abs(y[n] - serial[n]));
+    }
+    EXPECT_LE(maxDifference, 1e-8);
+    EXPECT_NEAR(y.back(), exp(sin(10.0)), 1e-8);
+    std::cout << "Parareal: " << parareal.statistics().iterations << " iterations, estimated speedup "
+              << parareal.estimatedSpeedup() << std::endl;
+    EXPECT_LT(parareal.statistics().iterations, 8);
+
+    // Exact after as many iterations as slices, even with a useless coarse propagator
+    auto useless = [](std::function<double(double, double)> f, double y0, double t0) -> std::unique_ptr<ODESolver> {
+        return std::make_unique<ExplicitEuler>([](double y, double t) { return 0.0; }, y0, t0);
+    };
+    Parareal slow(f, 1.0, 0.0, 4, nullptr, 0.05, useless);
+    std::vector<double> ySlow = slow.solve(0.01, 2.0);
+    EXPECT_EQ(slow.statistics().iterations, 4);
+    EXPECT_NEAR(ySlow.back(), RungeKutta(f, 1.0, 0.0).solve(0.01, 2.0).back(), 1e-12);
+}
+
+TEST(ODESolvers, RIDC) {
+    // y' = cos(t) y with exact solution exp(sin t)
+    auto f = [](double y, double t) { return cos(t) * y; };
+    auto df = [](double y, double t) { return cos(t); };
+    for (auto variant: {RIDC::Variant::Explicit, RIDC::Variant::Implicit}) {
+        for (unsigned int order: {2u, 4u}) {
+            std::vector<double> errors;
+            // Steps large enough for the error to stay above the Newton tolerance
+            for (double h: {0.1, 0.05}) {
+                std::vector<double> y = RIDC(f, 1.0, 0.0, order, variant, df).solve(h, 2.0);
+                ASSERT_EQ(y.size(), std::lround(2.0 / h) + 1);
+                errors.push_back(std::abs(y.back() - exp(sin(2.0))));
+            }
+            std::cout << "RIDC order " << order << " error ratio " << errors[0] / errors[1] << std::endl;
+            EXPECT_GE(log2(errors[0] / errors[1]), order - 0.5);
+        }
+    }
+
+    // The implicit variant is stable on a stiff problem
+    auto stiff = [](double y, double t) { return -1000 * (y - cos(t)); };
+    auto dStiff = [](double y, double t) { return -1000.0; };
+    std::vector<double> y = RIDC(stiff, 1.0, 0.0, 3, RIDC::Variant::Implicit, dStiff).solve(0.05, 1.0);
+    ASSERT_EQ(y.size(), 21);
+    EXPECT_NEAR(y.back(), cos(1.0), 1e-3);
+}
+
+TEST(ODESystemSolvers, WaveformRelaxation) {
+    // Chain of decays y_i' = -a_i y_i + 0.1 (y_{i-1} - 2 y_i + y_{i+1}), cut into 4 partitions of 10 components
+    const unsigned int n = 40;
+    const unsigned int size = 10;
+    SystemFunction f = [](const std::vector<double>& y, double t, std::vector<double>& dydt) {
+        for (unsigned int i = 0; i < n; i++) {
+            double left = i > 0 ? y[i - 1] : 0.0;
+            double right = i + 1 < n ? y[i + 1] : 0.0;
+            dydt[i] = -(1.0 + i % 3) * y[i] + 0.1 * (left - 2 * y[i] + right) + sin(t);
+        }
+    };
+    // The coupling variables are the left neighbour of the first and the right neighbour of the last component
+    WaveformRelaxation::PartitionFunction partitionF = [](unsigned int p, const std::vector<double>& z,
+                                                          const std::vector<double>& coupling, double t,
+                                                          std::vector<double>& dydt) {
+        double leftEnd = p > 0 ? coupling.front() : 0.0;
+        double rightEnd = p + 1 < n / size ? coupling.back() : 0.0;
+        for (unsigned int k = 0; k < size; k++) {
+            unsigned int i = p * size + k;
+            double left = k > 0 ? z[k - 1] : leftEnd;
+            double right = k + 1 < size ? z[k + 1] : rightEnd;
+            dydt[k] = -(1.0 + i % 3) * z[k] + 0.1 * (left - 2 * z[k] + right) + sin(t);
+        }
+    };
+    std::vector<WaveformRelaxation::Partition> partitions(n / size);
+    for (unsigned int p = 0; p < partitions.size(); p++) {
+        for (unsigned int k = 0; k < size; k++) {
+            partitions[p].components.push_back(p * size + k);
+        }
+        if (p > 0) {
+            partitions[p].coupling.push_back(p * size - 1);
+        }
+        if (p + 1 < partitions.size()) {
+            partitions[p].coupling.push_back((p + 1) * size);
+        }
+    }
+    std::vector<double> y0(n);
+    for (unsigned int i = 0; i < n; i++) {
+        y0[i] = cos(i);
+    }
+    ODESystemSolverFactory bulirschStoer = [](SystemFunction f, std::vector<double> y0, double t0) {
+        return std::make_unique<BulirschStoer>(std::move(f), std::move(y0), t0, 1e-11);
+    };
+    std::vector<std::vector<double>> reference = BulirschStoer(f, y0, 0.0, 1e-11).solve(0.05, 2.0);
+    unsigned int jacobiIterations = 0;
+    for (auto method: {WaveformRelaxation::Method::Jacobi, WaveformRelaxation::Method::GaussSeidel}) {
+        WaveformRelaxation solver(partitionF, partitions, y0, 0.0, bulirschStoer, 10, method,
+                                  std::make_shared<ThreadPool>(4));
+        std::vector<std::vector<double>> y = solver.solve(0.05, 2.0);
+        ASSERT_EQ(y.size(), reference.size());
+        double maxError = 0.0;
+        for (unsigned int k = 0; k < y.size(); k++) {
+            for (unsigned int i = 0; i < n; i++) {
+                maxError = std::max(maxError, std::abs(y[k][i] - reference[k][i]));
+            }
+        }
+        // Limited by the cubic interpolation of the coupling variables
+        EXPECT_LE(maxError, 1e-6);
+        std::cout << "Waveform relaxation: " << solver.iterations() << " iterations over 4 windows" << std::endl;
+        if (method == WaveformRelaxation::Method::Jacobi) {
+            jacobiIterations = solver.iterations();
+        } else {
+            EXPECT_LT(solver.iterations(), jacobiIterations);
+        }
+    }
+
+    // Partition solvers that evaluate f concurrently
+    ODESystemSolverFactory parallelBulirschStoer = [](SystemFunction f, std::vector<double> y0, double t0) {
+        return std::make_unique<BulirschStoer>(std::move(f), std::move(y0), t0, 1e-11, 10,
+                                               std::make_shared<ThreadPool>(4));
+    };
+    WaveformRelaxation parallel(partitionF, partitions, y0, 0.0, parallelBulirschStoer, 10,
+                                WaveformRelaxation::Method::GaussSeidel);
+    EXPECT_LE(utilities::calculateRMSE(parallel.solve(0.05, 2.0).back(), reference.back()), 1e-6);
+
+    // A window that does not converge within maxIterations is reported
+    WaveformRelaxation limited(partitionF, partitions, y0, 0.0, bulirschStoer, 10, WaveformRelaxation::Method::Jacobi,
+                               nullptr, 1e-10, 2);
+    EXPECT_THROW(limited.solve(0.05, 2.0), std::runtime_error);
+
+    // As does a partition solver that stops inside the window
+    ODESystemSolverFactory stopping = [](SystemFunction f, std::vector<double> y0, double t0) {
+        auto solver = std::make_unique<BulirschStoer>(std::move(f), std::move(y0), t0, 1e-11);
+        Event stop;
+        stop.g = [](const std::vector<double>& y, double t) { return t - 0.42; };
+        stop.terminal = true;
+        solver->setEvents({stop});
+        return solver;
+    };
+    WaveformRelaxation stopped(partitionF, partitions, y0, 0.0, stopping, 10);
+    EXPECT_THROW(stopped.solve(0.05, 2.0), std::runtime_error);
+}
+
+TEST(ODESystemSolvers, MethodOfLines) {
+    // Heat equation u_t = D u_xx on [0, 1] with u = 0 on the boundary and exact solution exp(-D pi^2 t) sin(pi x)
+    const double D = 0.1;
+    MethodOfLines heat({99}, D);
+    ASSERT_EQ(heat.size(), 99);
+    std::vector<double> u0(heat.size());
+    for (unsigned int k = 0; k < heat.size(); k++) {
+        u0[k] = sin(M_PI * heat.point(k)[0]);
+    }
+    AdditiveRungeKutta solver(heat.transportPart(), heat.diffusionPart(), u0, 0.0,
+                              std::make_unique<SparseLinearSolver>(heat.jacobian(true)));
+    std::vector<std::vector<double>> u = solver.solve(0.05, 1.0);
+    ASSERT_EQ(u.size(), 21);
+    double maxError = 0.0;
+    for (unsigned int k = 0; k < heat.size(); k++) {
+        maxError = std::max(maxError, std::abs(u.back()[k] - exp(-D * M_PI * M_PI) * u0[k]));
+    }
+    EXPECT_LE(maxError, 1e-4);
+    EXPECT_EQ(heat.bandwidth(), std::make_pair(1u, 1u));
+
+    // Periodic 2D advection-diffusion-reaction, the exported Jacobian matches difference quotients of the rhs
+    MethodOfLines::Grid grid{8, 6, 1.0, 2.0, MethodOfLines::Boundary::Periodic};
+    MethodOfLines::ReactionFunction logistic = [](const std::vector<double>& u, double t, std::vector<double>& r) {
+        for (unsigned int k = 0; k < u.size(); k++) {
+            r[k] = u[k] * (1 - u[k]);
+        }
+    };
+    MethodOfLines model(grid, 0.01, {1.0, -0.5}, logistic);
+    CSRMatrix pattern = model.jacobianPattern();
+    EXPECT_EQ(pattern.nonZeros(), 5 * model.size());
+    EXPECT_EQ(model.bandwidth(), std::make_pair(8u, 8u));
+    std::vector<double> y(model.size());
+    for (unsigned int k = 0; k < model.size(); k++) {
+        auto [x1, x2] = model.point(k);
+        y[k] = 0.5 + 0.3 * sin(2 * M_PI * x1) * cos(M_PI * x2);
+    }
+    CSRMatrix J;
+    model.jacobian()(y, 0.0, J);
+    EXPECT_EQ(J.colIdx, pattern.colIdx);
+    SystemFunction f = model.rhs();
+    std::vector<double> fy(model.size()), fShifted(model.size()), shifted = y;
+    f(y, 0.0, fy);
+    const double eps = 1e-7;
+    for (unsigned int k = 0; k < model.size(); k += 7) {
+        shifted[k] += eps;
+        f(shifted, 0.0, fShifted);
+        shifted[k] = y[k];
+        for (unsigned int i = 0; i < model.size(); i++) {
+            int entry = J.find(i, k);
+            double expected = (fShifted[i] - fy[i]) / eps;
+            EXPECT_NEAR(entry < 0 ? 0.0 : J.values[entry], expected, 1e-5);
+        }
+    }
+}
+
+TEST(LinearAlgebra, BandedLU) {
+    for (auto [n, kl, ku]: std::vector<std::array<unsigned int, 3>>{{1, 0, 0}, {8, 1, 1}, {50, 2, 3}, {60, 4, 1}}) {
+        // Zero diagonal forces pivoting, the result is compared with DenseLU on the same matrix
+        BandedMatrix A(n, kl, ku);
+        std::vector<double> dense(n * n, 0.0), x(n), b;
+        for (unsigned int i = 0; i < n; i++) {
+            x[i] = cos(i);
+            for (unsigned int j = 0; j < n; j++) {
+                if (A.inBand(i, j)) {
+                    A(i, j) = i == j && n > 1 ? 0.0 : sin(i * n + j + 1.0);
+                    dense[i * n + j] = A(i, j);
+                }
+            }
+        }
+        A.multiply(x, b);
+        std::vector<double> bDense = b;
+        BandedLU lu;
+        lu.factorize(A);
+        lu.solve(b);
+        EXPECT_LE(utilities::calculateRMSE(b, x), 1e-10) << n;
+        DenseLU reference;
+        reference.factorize(dense, n);
+        reference.solve(bDense);
+        EXPECT_LE(utilities::calculateRMSE(b, bDense), 1e-10) << n;
+    }
+    BandedLU lu;
+    EXPECT_THROW(lu.factorize(BandedMatrix(3, 1, 1)), std::runtime_error);
+}
+
+TEST(ODESystemSolvers, ImplicitEulerSystemBanded) {
+    ImplicitEulerSystem dense(stiffChain::f, stiffChain::y0(), 0.0, stiffChain::denseJacobian);
+    ImplicitEulerSystem banded(stiffChain::f, stiffChain::y0(), 0.0,
+                               std::make_unique<BandedLinearSolver>(stiffChain::bandedJacobian, 1, 1));
+    std::vector<std::vector<double>> yDense = dense.solve(1e-2, 1.0);
+    std::vector<std::vector<double>> yBanded = banded.solve(1e-2, 1.0);
+    ASSERT_EQ(yBanded.size(), 101);
+    EXPECT_LE(utilities::calculateRMSE(yBanded.back(), yDense.back()), 1e-7);
+
+    // The banded Jacobian of a method-of-lines problem equals the sparse one
+    MethodOfLines::ReactionFunction cubic = [](const std::vector<double>& u, double t, std::vector<double>& r) {
+        for (unsigned int k = 0; k < u.size(); k++) {
+            r[k] = -u[k] * u[k] * u[k];
+        }
+    };
+    MethodOfLines model({12, 5}, 0.1, {0.5, 1.0}, cubic);
+    auto [kl, ku] = model.bandwidth();
+    std::vector<double> u(model.size());
+    for (unsigned int k = 0; k < model.size(); k++) {
+        u[k] = sin(k + 1.0);
+    }
+    CSRMatrix J;
+    model.jacobian()(u, 0.0, J);
+    BandedMatrix B(model.size(), kl, ku);
+    model.bandedJacobian()(u, 0.0, B);
+    std::vector<double> Ju, Bu;
+    J.multiply(u, Ju);
+    B.multiply(u, Bu);
+    EXPECT_LE(utilities::calculateRMSE(Bu, Ju), 1e-12);
+    EXPECT_THROW(MethodOfLines({8, 1, 1.0, 1.0, MethodOfLines::Boundary::Periodic}, 0.1).bandedJacobian(),
+                 std::invalid_argument);
+}
+
+TEST(ODESystemSolvers, ImplicitEulerSystemMassMatrix) {
+    // Index 1 DAE y1' = -y1 + y2, 0 = y2 - sin(t) with y1(0) = 1 and an inconsistent guess of y2(0)
+    SystemFunction f = [](const std::vector<double>& y, double t, std::vector<double>& dydt) {
+        dydt[0] = -y[0] + y[1];
+        dydt[1] = y[1] - sin(t);
+    };
+    DenseJacobianFunction denseJacobian = [](const std::vector<double>& y, double t, std::vector<double>& J) {
+        J = {-1.0, 1.0, 0.0, 1.0};
+    };
+    SparseJacobianFunction sparseJacobian = [](const std::vector<double>& y, double t, CSRMatrix& J) {
+        J = CSRMatrix::fromTriplets(2, 2, {{0, 0, -1.0}, {0, 1, 1.0}, {1, 1, 1.0}});
+    };
+    BandedJacobianFunction bandedJacobian = [](const std::vector<double>& y, double t, BandedMatrix& J) {
+        J(0, 0) = -1.0;
+        J(0, 1) = 1.0;
+        J(1, 1) = 1.0;
+    };
+    MassMatrixFunction mass = [](const std::vector<double>& y, double t, CSRMatrix& M) {
+        M = CSRMatrix::fromTriplets(2, 2, {{0, 0, 1.0}});
+    };
+    auto exact = [](double t) { return (sin(t) - cos(t)) / 2 + 1.5 * exp(-t); };
+
+    ImplicitEulerSystem dense(f, {1.0, 0.7}, 0.0, denseJacobian);
+    dense.setMassMatrix(mass);
+    std::vector<std::vector<double>> y = dense.solve(1e-3, 1.0);
+    ASSERT_EQ(y.size(), 1001);
+    EXPECT_NEAR(y[0][0], 1.0, 1e-15);
+    EXPECT_NEAR(y[0][1], 0.0, 1e-9);
+    double algebraicError = 0.0;
+    for (unsigned int n = 0; n < y.size(); n++) {
+        algebraicError = std::max(algebraicError, std::abs(y[n][1] - sin(n * 1e-3)));
+    }
+    EXPECT_LE(algebraicError, 1e-8);
+    std::cout << "DAE error at t = 1: " << std::abs(y.back()[0] - exact(1.0)) << std::endl;
+    EXPECT_LE(std::abs(y.back()[0] - exact(1.0)), 1e-3);
+
+    ImplicitEulerSystem sparse(f, {1.0, 0.7}, 0.0, std::make_unique<SparseLinearSolver>(sparseJacobian));
+    sparse.setMassMatrix(mass);
+    EXPECT_LE(utilities::calculateRMSE(sparse.solve(1e-3, 1.0).back(), y.back()), 1e-10);
+    ImplicitEulerSystem banded(f, {1.0, 0.7}, 0.0, std::make_unique<BandedLinearSolver>(bandedJacobian, 1, 1));
+    banded.setMassMatrix(mass);
+    EXPECT_LE(utilities::calculateRMSE(banded.solve(1e-3, 1.0).back(), y.back()), 1e-10);
+
+    // u' = -u, 0 = z2 - u, 0 = z1 + z2 - 3u, the algebraic rows of M - gamma * J have a zero diagonal (z1 only
+    // appears in the last row), the sparse LU matches rows and columns before the static pivoting
+    SystemFunction chain = [](const std::vector<double>& y, double t, std::vector<double>& dydt) {
+        dydt[0] = -y[0];
+        dydt[1] = y[2] - y[0];
+        dydt[2] = y[1] + y[2] - 3 * y[0];
+    };
+    DenseJacobianFunction chainDense = [](const std::vector<double>& y, double t, std::vector<double>& J) {
+        J = {-1.0, 0.0, 0.0, -1.0, 0.0, 1.0, -3.0, 1.0, 1.0};
+    };
+    SparseJacobianFunction chainSparse = [](const std::vector<double>& y, double t, CSRMatrix& J) {
+        J = CSRMatrix::fromTriplets(3, 3, {{0, 0, -1.0}, {1, 0, -1.0}, {1, 2, 1.0}, {2, 0, -3.0}, {2, 1, 1.0},
+                                           {2, 2, 1.0}});
+    };
+    MassMatrixFunction chainMass = [](const std::vector<double>& y, double t, CSRMatrix& M) {
+        M = CSRMatrix::fromTriplets(3, 3, {{0, 0, 1.0}});
+    };
+    ImplicitEulerSystem chainReference(chain, {1.0, 0.0, 0.0}, 0.0, chainDense);
+    chainReference.setMassMatrix(chainMass);
+    std::vector<double> chainEnd = chainReference.solve(1e-2, 1.0).back();
+    EXPECT_NEAR(chainEnd[1], 2 * chainEnd[0], 1e-9);
+    EXPECT_NEAR(chainEnd[2], chainEnd[0], 1e-9);
+    for (SparseLU::Ordering ordering: {SparseLU::Ordering::Natural, SparseLU::Ordering::MinimumDegree}) {
+        ImplicitEulerSystem chainSolver(chain, {1.0, 0.0, 0.0}, 0.0,
+                                        std::make_unique<SparseLinearSolver>(chainSparse, ordering));
+        chainSolver.setMassMatrix(chainMass);
+        EXPECT_LE(utilities::calculateRMSE(chainSolver.solve(1e-2, 1.0).back(), chainEnd), 1e-10);
+    }
+
+    // State dependent mass (1 + y1^2) y1' = -y1 (1 + y1^2), 0 = y2 - y1^2, so y1 = exp(-t) and y2 = y1^2
+    SystemFunction g = [](const std::vector<double>& y, double t, std::vector<double>& dydt) {
+        dydt[0] = -y[0] * (1 + y[0] * y[0]);
+        dydt[1] = y[1] - y[0] * y[0];
+    };
+    DenseJacobianFunction gJacobian = [](const std::vector<double>& y, double t, std::vector<double>& J) {
+        J = {-1 - 3 * y[0] * y[0], 0.0, -2 * y[0], 1.0};
+    };
+    MassMatrixFunction stateMass = [](const std::vector<double>& y, double t, CSRMatrix& M) {
+        M = CSRMatrix::fromTriplets(2, 2, {{0, 0, 1 + y[0] * y[0]}});
+    };
+    ImplicitEulerSystem nonlinear(g, {1.0, 5.0}, 0.0, gJacobian);
+    nonlinear.setMassMatrix(stateMass, false);
+    std::vector<std::vector<double>> z = nonlinear.solve(1e-3, 1.0);
+    EXPECT_NEAR(z[0][1], 1.0, 1e-9);
+    EXPECT_NEAR(z.back()[0], exp(-1.0), 1e-3);
+    EXPECT_NEAR(z.back()[1], z.back()[0] * z.back()[0], 1e-8);
+
+    // Methods and linear solvers without mass matrix support
+    AdditiveRungeKutta ark(f, f, {1.0, 0.0}, 0.0, denseJacobian);
+    ark.setMassMatrix(mass);
+    EXPECT_THROW(ark.solve(1e-2, 1.0), std::invalid_argument);
+    JacobianFreeLinearSolver jacobianFree(f);
+    EXPECT_THROW(jacobianFree.setMassMatrix(mass), std::invalid_argument);
+}
+
+TEST(ODESystemSolvers, ImplicitEulerSystemSensitivities) {
+    // Chain y_i' = p_{i-1} y_{i-1} - p_i y_i with one rate per component
+    const unsigned int n = 12;
+    auto model = [n](const std::vector<double>& p, unsigned long* evaluations) {
+        SystemFunction f = [n, p, evaluations](const std::vector<double>& y, double t, std::vector<double>& dydt) {
+            (*evaluations)++;
+            for (unsigned int i = 0; i < n; i++) {
+                dydt[i] = (i > 0 ? p[i - 1] * y[i - 1] : 0.0) - p[i] * y[i];
+            }
+        };
+        DenseJacobianFunction jacobian = [n, p](const std::vector<double>& y, double t, std::vector<double>& J) {
+            for (unsigned int i = 0; i < n; i++) {
+                J[i * n + i] = -p[i];
+                if (i > 0) {
+                    J[i * n + i - 1] = p[i - 1];
+                }
+            }
+        };
+        ParameterJacobianFunction dfdp = [n](const std::vector<double>& y, double t, std::vector<double>& D) {
+            for (unsigned int i = 0; i < n; i++) {
+                D[i * n + i] = -y[i];
+                if (i > 0) {
+                    D[i * n + i - 1] = y[i - 1];
+                }
+            }
+        };
+        return std::make_tuple(f, jacobian, dfdp);
+    };
+    std::vector<double> p(n), y0(n, 0.0);
+    for (unsigned int i = 0; i < n; i++) {
+        p[i] = 1.0 + 0.25 * i;
+    }
+    y0[0] = 1.0;
+
+    // Evaluations of f, the parameter derivatives add one evaluation of the same cost per step
+    unsigned long evaluations = 0;
+    auto [f, jacobian, dfdp] = model(p, &evaluations);
+    ImplicitEulerSystem solver(f, y0, 0.0, jacobian);
+    solver.setSensitivities(dfdp, n);
+    std::vector<std::vector<double>> y = solver.solve(1e-2, 2.0);
+    const std::vector<std::vector<double>>& S = solver.sensitivities();
+    ASSERT_EQ(S.size(), y.size());
+    const unsigned long sensitivityEvaluations = evaluations + y.size() - 1;
+
+    // Central differences of whole solves, two per parameter
+    evaluations = 0;
+    double error = 0.0;
+    double scale = 0.0;
+    for (unsigned int j = 0; j < n; j++) {
+        std::vector<double> plus = p, minus = p;
+        plus[j] += 1e-6;
+        minus[j] -= 1e-6;
+        auto [fPlus, jacobianPlus, dfdpPlus] = model(plus, &evaluations);
+        auto [fMinus, jacobianMinus, dfdpMinus] = model(minus, &evaluations);
+        std::vector<double> yPlus = ImplicitEulerSystem(fPlus, y0, 0.0, jacobianPlus).solve(1e-2, 2.0).back();
+        std::vector<double> yMinus = ImplicitEulerSystem(fMinus, y0, 0.0, jacobianMinus).solve(1e-2, 2.0).back();
+        for (unsigned int i = 0; i < n; i++) {
+            error = std::max(error, std::abs((yPlus[i] - yMinus[i]) / 2e-6 - S.back()[i * n + j]));
+            scale = std::max(scale, std::abs(S.back()[i * n + j]));
+        }
+    }
+    std::cout << "Sensitivities: " << sensitivityEvaluations << " evaluations, finite differences: " << evaluations
+              << ", difference " << error << std::endl;
+    EXPECT_LE(error, 1e-7 * scale);
+    EXPECT_LT(5 * sensitivityEvaluations, evaluations);
+
+    // The batched dense solve and the default one of the sparse solver agree
+    SparseJacobianFunction sparseJacobian = [n, p](const std::vector<double>& y, double t, CSRMatrix& J) {
+        std::vector<Triplet> triplets;
+        for (unsigned int i = 0; i < n; i++) {
+            triplets.push_back({i, i, -p[i]});
+            if (i > 0) {
+                triplets.push_back({i, i - 1, p[i - 1]});
+            }
+        }
+        J = CSRMatrix::fromTriplets(n, n, triplets);
+    };
+    ImplicitEulerSystem sparse(f, y0, 0.0, std::make_unique<SparseLinearSolver>(sparseJacobian));
+    sparse.setSensitivities(dfdp, n);
+    sparse.solve(1e-2, 2.0);
+    EXPECT_LE(utilities::calculateRMSE(sparse.sensitivities().back(), S.back()), 1e-12);
+    EXPECT_THROW(solver.setSensitivities(dfdp, n, std::vector<double>(3)), std::invalid_argument);
+}
+
+TEST(ODESystemSolvers, AdjointImplicitEuler) {
+    // Lotka-Volterra y1' = a y1 - b y1 y2, y2' = c y1 y2 - d y2 with the objective g = y1(tEnd) + y2(tEnd)^2
+    auto model = [](const std::vector<double>& p) {
+        SystemFunction f = [p](const std::vector<double>& y, double t, std::vector<double>& dydt) {
+            dydt[0] = p[0] * y[0] - p[1] * y[0] * y[1];
+            dydt[1] = p[2] * y[0] * y[1] - p[3] * y[1];
+        };
+        return f;
+    };
+    DenseJacobianFunction jacobian;
+    std::vector<double> p = {1.5, 1.0, 1.0, 3.0};
+    jacobian = [&p](const std::vector<double>& y, double t, std::vector<double>& J) {
+        J = {p[0] - p[1] * y[1], -p[1] * y[0], p[2] * y[1], p[2] * y[0] - p[3]};
+    };
+    ParameterAdjointFunction dfdp = [](const std::vector<double>& y, double t, const std::vector<double>& lambda,
+                                       std::vector<double>& grad) {
+        grad[0] += lambda[0] * y[0];
+        grad[1] -= lambda[0] * y[0] * y[1];
+        grad[2] += lambda[1] * y[0] * y[1];
+        grad[3] -= lambda[1] * y[1];
+    };
+    auto dgdy = [](const std::vector<double>& y) { return std::vector<double>{1.0, 2 * y[1]}; };
+    auto objective = [](const std::vector<double>& y) { return y[0] + y[1] * y[1]; };
+    const std::vector<double> y0 = {1.0, 1.0};
+
+    // All states stored versus five checkpoints for 300 steps
+    AdjointImplicitEuler full(model(p), jacobian, dfdp, 4, y0, 0.0, 301);
+    AdjointImplicitEuler::Result reference = full.gradient(dgdy, 0.01, 3.0);
+    AdjointImplicitEuler revolve(model(p), jacobian, dfdp, 4, y0, 0.0, 5);
+    AdjointImplicitEuler::Result result = revolve.gradient(dgdy, 0.01, 3.0);
+    EXPECT_EQ(result.gradient, reference.gradient);
+    EXPECT_EQ(result.initialGradient, reference.initialGradient);
+    EXPECT_EQ(revolve.statistics().adjointSteps, 300);
+    EXPECT_LE(revolve.statistics().maxCheckpoints, 5);
+    // Five checkpoints cover 300 steps with r = 5 recomputations, binomial(4 + 5, 4) = 126 < 300 <= binomial(10, 4)
+    EXPECT_LE(revolve.statistics().forwardSteps, 7 * 300);
+    std::cout << "Adjoint with 5 checkpoints: " << revolve.statistics().forwardSteps << " forward steps, with all "
+              << "states: " << full.statistics().forwardSteps << std::endl;
+
+    // Central differences of the objective
+    double error = 0.0;
+    for (unsigned int j = 0; j < 4; j++) {
+        std::vector<double> plus = p, minus = p;
+        plus[j] += 1e-6;
+        minus[j] -= 1e-6;
+        auto end = [&](const std::vector<double>& q) {
+            DenseJacobianFunction J = [q](const std::vector<double>& y, double t, std::vector<double>& J) {
+                J = {q[0] - q[1] * y[1], -q[1] * y[0], q[2] * y[1], q[2] * y[0] - q[3]};
+            };
+            return AdjointImplicitEuler(model(q), J, dfdp, 4, y0, 0.0, 10).gradient(dgdy, 0.01, 3.0).yEnd;
+        };
+        double difference = (objective(end(plus)) - objective(end(minus))) / 2e-6;
+        error = std::max(error, std::abs(difference - result.gradient[j]) / (1 + std::abs(difference)));
+    }
+    for (unsigned int i = 0; i < 2; i++) {
+        std::vector<double> plus = y0, minus = y0;
+        plus[i] += 1e-6;
+        minus[i] -= 1e-6;
+        double difference = (objective(AdjointImplicitEuler(model(p), jacobian, dfdp, 4, plus, 0.0, 10)
+                                               .gradient(dgdy, 0.01, 3.0).yEnd) -
+                             objective(AdjointImplicitEuler(model(p), jacobian, dfdp, 4, minus, 0.0, 10)
+                                               .gradient(dgdy, 0.01, 3.0).yEnd)) / 2e-6;
+        error = std::max(error, std::abs(difference - result.initialGradient[i]) / (1 + std::abs(difference)));
+    }
+    std::cout << "Adjoint gradient versus central differences: " << error << std::endl;
+    EXPECT_LE(error, 1e-6);
+    EXPECT_THROW(AdjointImplicitEuler(model(p), jacobian, dfdp, 4, y0, 0.0, 0), std::invalid_argument);
+}
+
+TEST(ODESolvers, DenseOutput) {
+    // Oscillator solved to 1e-12 at coarse steps, the interpolation error dominates between them
+    SystemFunction oscillator = [](const std::vector<double>& y, double t, std::vector<double>& dydt) {
+        dydt[0] = y[1];
+        dydt[1] = -y[0];
+    };
+    BulirschStoer solver(oscillator, {1.0, 0.0}, 0.0, 1e-12);
+    DenseOutput cubic = solver.solveDense(0.5, 10.0);
+    DenseOutput quintic = solver.solveDense(0.5, 10.0, DenseOutput::Order::Quintic);
+    EXPECT_DOUBLE_EQ(cubic.end(), 10.0);
+    EXPECT_NEAR(cubic(1.5)[0], cubic.values()[3][0], 1e-14);
+    double cubicError = 0.0;
+    double quinticError = 0.0;
+    std::vector<double> y;
+    for (unsigned int k = 0; k <= 1000; k++) {
+        double t = 0.01 * k;
+        cubic.evaluate(t, y);
+        cubicError = std::max(cubicError, std::abs(y[0] - cos(t)) + std::abs(y[1] + sin(t)));
+        quintic.evaluate(t, y);
+        quinticError = std::max(quinticError, std::abs(y[0] - cos(t)) + std::abs(y[1] + sin(t)));
+    }
+    std::cout << "Dense output error cubic/quintic: " << cubicError << "/" << quinticError << std::endl;
+    EXPECT_LT(cubicError, 1e-3);
+    EXPECT_LT(quinticError, 1e-5);
+    EXPECT_LT(20 * quinticError, cubicError);
+    EXPECT_THROW(cubic(10.5), std::out_of_range);
+
+    // Scalar solvers, y' = y
+    RungeKutta growth([](double y, double t) { return y; }, 1.0, 0.0);
+    DenseOutput exponential = growth.solveDense(0.1, 1.0, DenseOutput::Order::Quintic);
+    EXPECT_NEAR(exponential(0.55)[0], exp(0.55), 1e-6);
+
+    // Without f the derivatives are differences of the values, exact for y = t^4
+    std::vector<std::vector<double>> quartic;
+    for (unsigned int n = 0; n <= 10; n++) {
+        quartic.push_back({pow(0.1 * n, 4)});
+    }
+    DenseOutput differences = DenseOutput::fromValues(0.0, 0.1, quartic, DenseOutput::Order::Quintic);
+    EXPECT_NEAR(differences(0.05)[0], pow(0.05, 4), 1e-12);
+    EXPECT_NEAR(differences(0.73)[0], pow(0.73, 4), 1e-12);
+
+    DelayFunction delayed = [](const std::vector<double>& y, const std::vector<std::vector<double>>& yDelayed,
+                               double t, std::vector<double>& dydt) {
+        dydt[0] = -yDelayed[0][0];
+    };
+    DelayRungeKutta delay(delayed, {1.0}, [](double t) { return std::vector<double>{1.0}; }, 0.0, 1e-10);
+    DenseOutput history = delay.solveDense(0.25, 1.0);
+    EXPECT_NEAR(history(0.4)[0], 0.6, 1e-8);
+
+    // Second order systems interpolate (q, v) with the derivatives (v, a)
+    AccelerationFunction spring = [](const std::vector<double>& q, double t, std::vector<double>& acc) {
+        acc[0] = -q[0];
+    };
+    RungeKuttaNystrom nystrom(spring, {1.0}, {0.0}, 0.0);
+    DenseOutput state = nystrom.solveDense(0.25, 5.0, DenseOutput::Order::Quintic);
+    std::vector<double> q = state(2.1);
+    ASSERT_EQ(q.size(), 2);
+    // Dominated by the fourth order error of the method at this step size
+    EXPECT_NEAR(q[0], cos(2.1), 1e-4);
+    EXPECT_NEAR(q[1], -sin(2.1), 1e-4);
+
+    // Paths of SDEs are interpolated from their values
+    SDESolver brownian([](double y, double t) { return 0.0; }, [](double y, double t) { return 1.0; }, 0.0, 0.0,
+                       SDESolver::Method::EulerMaruyama, 5);
+    std::vector<double> path = brownian.solve(0.1, 1.0);
+    DenseOutput pathOutput = brownian.solveDense(0.1, 1.0);
+    for (unsigned int n = 0; n < path.size(); n++) {
+        EXPECT_NEAR(pathOutput(0.1 * n)[0], path[n], 1e-12);
+    }
+}
+
+TEST(ODESystemSolvers, DelayRungeKutta) {
+    // y'(t) = -y(t - 1) with y = 1 for t <= 0, exact solution by the method of steps on [0, 3]
+    DelayFunction f = [](const std::vector<double>& y, const std::vector<std::vector<double>>& yDelayed, double t,
+                         std::vector<double>& dydt) {
+        dydt[0] = -yDelayed[0][0];
+    };
+    HistoryFunction history = [](double t) { return std::vector<double>{1.0}; };
+    auto exact = [](double t) {
+        double y = 1 - t;
+        if (t > 1) y += (t - 1) * (t - 1) / 2;
+        if (t > 2) y -= (t - 2) * (t - 2) * (t - 2) / 6;
+        return y;
+    };
+    DelayRungeKutta tracked(f, {1.0}, history, 0.0, 1e-8);
+    std::vector<std::vector<double>> y = tracked.solve(0.25, 3.0);
+    ASSERT_EQ(y.size(), 13);
+    for (unsigned int n = 0; n < y.size(); n++) {
+        EXPECT_NEAR(y[n][0], exact(n * 0.25), 1e-7) << n;
+    }
+    EXPECT_EQ(tracked.discontinuities(3.0, 3), std::vector<double>({1.0, 2.0, 3.0}));
+
+    // Without tracking, the steps across the discontinuities are rejected (the output grid misses them)
+    DelayRungeKutta untracked(f, {1.0}, history, 0.0, 1e-8, false);
+    untracked.solve(0.3, 3.0);
+    tracked.solve(0.3, 3.0);
+    std::cout << "Rejected steps with/without discontinuity tracking: " << tracked.statistics().rejectedSteps << "/"
+              << untracked.statistics().rejectedSteps << std::endl;
+    EXPECT_LT(tracked.statistics().rejectedSteps, untracked.statistics().rejectedSteps);
+
+    // Two delays on a long interval, the history buffer only holds the last maximum delay
+    DelayFunction twoDelays = [](const std::vector<double>& y, const std::vector<std::vector<double>>& yDelayed,
+                                 double t, std::vector<double>& dydt) {
+        dydt[0] = -0.5 * yDelayed[0][0] - 0.3 * yDelayed[1][0] + 0.1 * y[1];
+        dydt[1] = -y[1] + yDelayed[1][0];
+    };
+    HistoryFunction curve = [](double t) { return std::vector<double>{cos(t), 1.0 + t}; };
+    DelayRungeKutta solver(twoDelays, {0.7, 1.3}, curve, 0.0, 1e-8);
+    std::vector<std::vector<double>> yLong = solver.solve(0.1, 50.0);
+    ASSERT_EQ(yLong.size(), 501);
+    std::cout << "History points: " << solver.statistics().historyPoints << " of "
+              << solver.statistics().acceptedSteps << " steps" << std::endl;
+    EXPECT_LT(solver.statistics().historyPoints, solver.statistics().acceptedSteps / 5);
+    DelayRungeKutta reference(twoDelays, {0.7, 1.3}, curve, 0.0, 1e-11);
+    EXPECT_LE(utilities::calculateRMSE(yLong.back(), reference.solve(0.1, 50.0).back()), 1e-5);
+}
+
+TEST(Parallel, Philox) {
+    // Known answers of Philox4x32-10 from Random123
+    EXPECT_EQ(Philox(0)({0, 0, 0, 0}), Philox::Block({0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    EXPECT_EQ(Philox(0x299f31d0a4093822)({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}),
+              Philox::Block({0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+    Philox rng(42);
+    double sum = 0.0, sumSquares = 0.0;
+    const unsigned int samples = 100000;
+    for (unsigned int i = 0; i < samples; i++) {
+        double z = rng.normal(7, i);
+        sum += z;
+        sumSquares += z * z;
+    }
+    EXPECT_NEAR(sum / samples, 0.0, 0.015);
+    EXPECT_NEAR(sumSquares / samples, 1.0, 0.015);
+}
+
+TEST(ODESolvers, SDESolver) {
+    // Geometric Brownian motion dy = mu y dt + sigma y dW, y(T) = y0 exp((mu - sigma^2 / 2) T + sigma W(T))
+    const double mu = 0.5, sigma = 0.8;
+    auto f = [mu](double y, double t) { return mu * y; };
+    auto g = [sigma](double y, double t) { return sigma * y; };
+    auto dg = [sigma](double y, double t) { return sigma; };
+    auto strongError = [&](SDESolver::Method method, double h) {
+        SDESolver solver(f, g, 1.0, 0.0, method, 3, dg, 1e-6);
+        double error = 0.0;
+        const unsigned int paths = 200;
+        for (unsigned int p = 0; p < paths; p++) {
+            double W = 0.0;
+            for (unsigned int n = 0; n < std::round(1.0 / h); n++) {
+                W += solver.increment(p, n, h);
+            }
+            error += std::abs(solver.path(h, 1.0, p).back() - exp(mu - sigma * sigma / 2 + sigma * W));
+        }
+        return error / paths;
+    };
+    double eulerCoarse = strongError(SDESolver::Method::EulerMaruyama, 1.0 / 32);
+    double eulerFine = strongError(SDESolver::Method::EulerMaruyama, 1.0 / 128);
+    double milsteinCoarse = strongError(SDESolver::Method::Milstein, 1.0 / 32);
+    double milsteinFine = strongError(SDESolver::Method::Milstein, 1.0 / 128);
+    double adaptive = strongError(SDESolver::Method::AdaptiveSRK, 1.0 / 32);
+    std::cout << "Strong errors EM: " << eulerCoarse << " " << eulerFine << ", Milstein: " << milsteinCoarse << " "
+              << milsteinFine << ", adaptive SRK: " << adaptive << std::endl;
+    // Ratios of about 2 and 4 for step sizes a factor 4 apart
+    EXPECT_GT(eulerCoarse / eulerFine, 1.4);
+    EXPECT_LT(eulerCoarse / eulerFine, 2.8);
+    EXPECT_GT(milsteinCoarse / milsteinFine, 2.5);
+    EXPECT_LT(adaptive, milsteinFine);
+
+    // Many paths in lanes and on threads give the same values as the single paths, the mean is y0 exp(mu T)
+    SDESolver solver(f, g, 1.0, 0.0, SDESolver::Method::Milstein, 11, dg);
+    const unsigned int paths = 20000;
+    std::vector<double> serial = solver.terminalValues(0.05, 1.0, paths);
+    std::vector<double> parallel = solver.terminalValues(0.05, 1.0, paths, std::make_shared<ThreadPool>(3));
+    EXPECT_EQ(serial, parallel);
+    EXPECT_EQ(serial[12345], solver.path(0.05, 1.0, 12345).back());
+    double mean = 0.0, variance = 0.0;
+    for (double y: serial) {
+        mean += y / paths;
+    }
+    for (double y: serial) {
+        variance += (y - mean) * (y - mean) / (paths - 1);
+    }
+    EXPECT_NEAR(mean, exp(mu), 3 * std::sqrt(variance / paths));
+}
+
+TEST(ODESolvers, MultilevelMonteCarlo) {
+    // E[y(1)] = y0 exp(mu) of geometric Brownian motion
+    const double mu = 0.05, sigma = 0.2, tol = 2e-3;
+    auto f = [mu](double y, double t) { return mu * y; };
+    auto g = [sigma](double y, double t) { return sigma * y; };
+    auto payoff = [](double y) { return y; };
+    std::vector<double> estimates, exact;
+    MultilevelMonteCarlo::Result result;
+    for (std::uint64_t seed = 0; seed < 4; seed++) {
+        SDESolver solver(f, g, 1.0, 0.0, SDESolver::Method::EulerMaruyama, seed);
+        MultilevelMonteCarlo mlmc(solver, payoff, 1.0, 2, std::make_shared<ThreadPool>(2));
+        result = mlmc.estimate(tol);
+        estimates.push_back(result.estimate);
+        exact.push_back(exp(mu));
+        EXPECT_LE(result.rmse, 1.5 * tol);
+        if (seed == 0) {
+            // The estimate does not depend on the threads
+            EXPECT_EQ(MultilevelMonteCarlo(solver, payoff, 1.0).estimate(tol).estimate, result.estimate);
+        }
+    }
+    double rmse = utilities::calculateRMSE(estimates, exact);
+    std::cout << "MLMC RMSE: " << rmse << " with " << result.levels.size() << " levels, savings over Monte Carlo: "
+              << result.savings() << std::endl;
+    EXPECT_LE(rmse, 2 * tol);
+    // The variance of the corrections decays with the level
+    EXPECT_LT(result.levels.back().variance, result.levels[1].variance);
+    EXPECT_GT(result.savings(), 1.0);
+}
+
+TEST(SecondOrderSolvers, RungeKuttaNystrom) {
+    // Harmonic oscillator q'' = -q with q(0) = 1, v(0) = 0, three evaluations per step
+    AccelerationFunction oscillator = [](const std::vector<double>& q, double t, std::vector<double>& acc) {
+        acc[0] = -q[0];
+    };
+    std::vector<double> errors;
+    for (double stepSize: {0.2, 0.1}) {
+        RungeKuttaNystrom solver(oscillator, {1.0}, {0.0}, 0.0);
+        SecondOrderSolver::Solution solution = solver.solve(stepSize, 10.0);
+        errors.push_back(std::abs(solution.q.back()[0] - cos(10.0)) + std::abs(solution.v.back()[0] + sin(10.0)));
+        EXPECT_EQ(solver.statistics().evaluations, 3 * solver.statistics().acceptedSteps + 1);
+    }
+    EXPECT_NEAR(log2(errors[0] / errors[1]), 4, 0.3);
+
+    // Kepler orbit with eccentricity 0.6, period 2 pi, adaptive steps concentrate at the perihelion
+    AccelerationFunction kepler = [](const std::vector<double>& q, double t, std::vector<double>& acc) {
+        double r = std::sqrt(q[0] * q[0] + q[1] * q[1]);
+        acc[0] = -q[0] / (r * r * r);
+        acc[1] = -q[1] / (r * r * r);
+    };
+    const double e = 0.6;
+    std::vector<double> q0 = {1 - e, 0.0}, v0 = {0.0, std::sqrt((1 + e) / (1 - e))};
+    RungeKuttaNystrom adaptive(kepler, q0, v0, 0.0, RungeKuttaNystrom::Method::RKN43, 1e-10);
+    SecondOrderSolver::Solution orbit = adaptive.solve(M_PI / 4, 2 * M_PI);
+    ASSERT_EQ(orbit.q.size(), 9);
+    EXPECT_LE(utilities::calculateRMSE(orbit.q.back(), q0), 1e-6);
+    EXPECT_LE(utilities::calculateRMSE(orbit.v.back(), v0), 1e-6);
+    const RungeKuttaNystrom::Statistics& stats = adaptive.statistics();
+    std::cout << "RKN43 steps: " << stats.acceptedSteps << " accepted, " << stats.rejectedSteps << " rejected, "
+              << stats.evaluations << " evaluations" << std::endl;
+    EXPECT_EQ(stats.evaluations, 3 * (stats.acceptedSteps + stats.rejectedSteps) + 1);
+    // Fixed steps with the same number of evaluations are less accurate
+    RungeKuttaNystrom fixed(kepler, q0, v0, 0.0);
+    SecondOrderSolver::Solution fixedOrbit = fixed.solve(2 * M_PI / (stats.acceptedSteps + stats.rejectedSteps),
+                                                         2 * M_PI);
+    EXPECT_GT(utilities::calculateRMSE(fixedOrbit.q.back(), q0), utilities::calculateRMSE(orbit.q.back(), q0));
+}
+
+TEST(ODESystemSolvers, MultipleShooting) {
+    ODESystemSolverFactory bulirschStoer = [](SystemFunction f, std::vector<double> y0, double t0) {
+        return std::make_unique<BulirschStoer>(std::move(f), std::move(y0), t0, 1e-11);
+    };
+    auto zero = [](double t) { return std::vector<double>{0.0, 0.0}; };
+
+    // Bratu problem y'' + exp(y) = 0, y(0) = y(1) = 0, lower solution in closed form
+    SystemFunction bratu = [](const std::vector<double>& y, double t, std::vector<double>& dydt) {
+        dydt[0] = y[1];
+        dydt[1] = -exp(y[0]);
+    };
+    DenseJacobianFunction bratuJacobian = [](const std::vector<double>& y, double t, std::vector<double>& J) {
+        J = {0.0, 1.0, -exp(y[0]), 0.0};
+    };
+    BoundaryFunction dirichlet = [](const std::vector<double>& ya, const std::vector<double>& yb,
+                                    std::vector<double>& r) {
+        r[0] = ya[0];
+        r[1] = yb[0];
+    };
+    const double theta = 1.5171645990507543685;
+    auto exact = [theta](double t) { return -2 * log(cosh((t - 0.5) * theta / 2) / cosh(theta / 4)); };
+    MultipleShooting serial(bratu, bratuJacobian, dirichlet, bulirschStoer, 8);
+    std::vector<std::vector<double>> y = serial.solve(zero, 0.0, 1.0, 0.05);
+    ASSERT_EQ(y.size(), 21);
+    double error = 0.0;
+    for (unsigned int k = 0; k < y.size(); k++) {
+        error = std::max(error, std::abs(y[k][0] - exact(k * 0.05)));
+    }
+    std::cout << "Bratu: " << serial.statistics().iterations << " Newton iterations, error " << error << std::endl;
+    EXPECT_LE(error, 1e-9);
+    EXPECT_LE(serial.statistics().residual, 1e-9);
+    MultipleShooting parallel(bratu, bratuJacobian, dirichlet, bulirschStoer, 8, std::make_shared<ThreadPool>(4));
+    EXPECT_EQ(parallel.solve(zero, 0.0, 1.0, 0.05), y);
+
+    // A segment solver that stops inside its segment is reported instead of reading past its solution
+    ODESystemSolverFactory stopping = [](SystemFunction f, std::vector<double> y0, double t0) {
+        auto solver = std::make_unique<BulirschStoer>(std::move(f), std::move(y0), t0, 1e-11);
+        Event stop;
+        stop.g = [](const std::vector<double>& y, double t) { return t - 0.42; };
+        stop.terminal = true;
+        solver->setEvents({stop});
+        return solver;
+    };
+    MultipleShooting stopped(bratu, bratuJacobian, dirichlet, stopping, 8);
+    EXPECT_THROW(stopped.solve(zero, 0.0, 1.0, 0.05), std::runtime_error);
+
+    // y'' = mu^2 y on [0, 5] with mu = 20: the segment sensitivities grow like exp(mu (b - a) / segments)
+    const double mu = 20.0;
+    SystemFunction growth = [mu](const std::vector<double>& y, double t, std::vector<double>& dydt) {
+        dydt[0] = y[1];
+        dydt[1] = mu * mu * y[0];
+    };
+    DenseJacobianFunction growthJacobian = [mu](const std::vector<double>& y, double t, std::vector<double>& J) {
+        J = {0.0, 1.0, mu * mu, 0.0};
+    };
+    BoundaryFunction ends = [](const std::vector<double>& ya, const std::vector<double>& yb, std::vector<double>& r) {
+        r[0] = ya[0] - 1.0;
+        r[1] = yb[0];
+    };
+    auto decay = [mu](double t) { return sinh(mu * (5.0 - t)) / sinh(mu * 5.0); };
+    MultipleShooting shooting(growth, growthJacobian, ends, bulirschStoer, 50, std::make_shared<ThreadPool>(4));
+    std::vector<std::vector<double>> z = shooting.solve(zero, 0.0, 5.0, 0.01);
+    double decayError = 0.0;
+    for (unsigned int k = 0; k < z.size(); k++) {
+        decayError = std::max(decayError, std::abs(z[k][0] - decay(k * 0.01)));
+    }
+    std::cout << "Growth problem with 50 segments: error " << decayError << std::endl;
+    EXPECT_LE(decayError, 1e-8);
+    // Single shooting amplifies the rounding errors of the initial slope by exp(100)
+    double singleError = INFINITY;
+    try {
+        std::vector<std::vector<double>> single = MultipleShooting(growth, growthJacobian, ends, bulirschStoer, 1)
+                .solve(zero, 0.0, 5.0, 0.01);
+        singleError = std::abs(single.back()[0]);
+    } catch (const std::runtime_error&) {}
+    std::cout << "Growth problem with single shooting: error " << singleError << std::endl;
+    EXPECT_GE(singleError, 1.0);
+}
+
+TEST(ODESolvers, Events) {
+    EXPECT_NEAR(EventDetector::brent([](double t) { return cos(t); }, 0.0, 2.0, 1.0, cos(2.0), 1e-14), M_PI / 2,
+                1e-13);
+
+    // y' = y reaches 2 at t = ln(2), the solution stops at the last step before
+    RungeKutta growth([](double y, double t) { return y; }, 1.0, 0.0);
+    Event threshold;
+    threshold.g = [](const std::vector<double>& y, double t) { return y[0] - 2.0; };
+    threshold.terminal = true;
+    growth.setEvents({threshold});
+    std::vector<double> y = growth.solve(0.1, 5.0);
+    ASSERT_EQ(growth.eventLog().size(), 1);
+    EXPECT_NEAR(growth.eventLog()[0].t, log(2.0), 1e-6);
+    EXPECT_NEAR(growth.eventLog()[0].y[0], 2.0, 1e-10);
+    EXPECT_EQ(y.size(), 7);
+
+    // Oscillator y = (cos t, -sin t), cos crosses zero at pi/2 + k pi, falling at pi/2 and 5pi/2
+    SystemFunction oscillator = [](const std::vector<double>& y, double t, std::vector<double>& dydt) {
+        dydt[0] = y[1];
+        dydt[1] = -y[0];
+    };
+    Event crossing;
+    crossing.g = [](const std::vector<double>& y, double t) { return y[0]; };
+    Event falling = crossing;
+    falling.direction = Event::Direction::Falling;
+    BulirschStoer solver(oscillator, {1.0, 0.0}, 0.0, 1e-12);
+    solver.setEvents({crossing, falling});
+    std::vector<std::vector<double>> z = solver.solve(0.05, 10.0);
+    EXPECT_EQ(z.size(), 201);
+    const std::vector<EventRecord>& events = solver.eventLog();
+    ASSERT_EQ(events.size(), 5);
+    std::vector<double> expected = {M_PI / 2, M_PI / 2, 3 * M_PI / 2, 5 * M_PI / 2, 5 * M_PI / 2};
+    std::vector<unsigned int> indices = {0, 1, 0, 0, 1};
+    for (unsigned int k = 0; k < events.size(); k++) {
+        EXPECT_EQ(events[k].event, indices[k]);
+        EXPECT_NEAR(events[k].t, expected[k], 1e-7);
+    }
+
+    // Falling ball with a terminal impact at sqrt(2 h / g), the interpolant of the quadratic is exact
+    SystemFunction ball = [](const std::vector<double>& y, double t, std::vector<double>& dydt) {
+        dydt[0] = y[1];
+        dydt[1] = -9.81;
+    };
+    Event impact;
+    impact.g = [](const std::vector<double>& y, double t) { return y[0]; };
+    impact.terminal = true;
+    impact.direction = Event::Direction::Falling;
+    BulirschStoer drop(ball, {10.0, 0.0}, 0.0);
+    drop.setEvents({impact});
+    std::vector<std::vector<double>> w = drop.solve(0.1, 10.0);
+    ASSERT_EQ(drop.eventLog().size(), 1);
+    std::cout << "Impact at t = " << drop.eventLog()[0].t << " after " << w.size() << " of 101 steps" << std::endl;
+    EXPECT_NEAR(drop.eventLog()[0].t, sqrt(20 / 9.81), 1e-10);
+    EXPECT_NEAR(drop.eventLog()[0].y[1], -sqrt(20 * 9.81), 1e-8);
+    EXPECT_EQ(w.size(), 15);
+
+    // y' = 1 split into an explicit part and a zero stiff part, the interpolant has to use the sum of both
+    SystemFunction one = [](const std::vector<double>& y, double t, std::vector<double>& dydt) { dydt[0] = 1.0; };
+    SystemFunction zero = [](const std::vector<double>& y, double t, std::vector<double>& dydt) { dydt[0] = 0.0; };
+    DenseJacobianFunction zeroJacobian = [](const std::vector<double>& y, double t, std::vector<double>& J) {
+        J[0] = 0.0;
+    };
+    Event half;
+    half.g = [](const std::vector<double>& y, double t) { return y[0] - 0.55; };
+    half.terminal = true;
+    AdditiveRungeKutta ark(one, zero, {0.0}, 0.0, zeroJacobian);
+    ark.setEvents({half});
+    EXPECT_EQ(ark.solve(0.1, 2.0).size(), 6);
+    ASSERT_EQ(ark.eventLog().size(), 1);
+    EXPECT_NEAR(ark.eventLog()[0].t, 0.55, 1e-10);
+
+    // The scalar wrapper of the configuration file stops in the wrapped solver
+    ScalarSystemSolver wrapped([](double y, double t) { return 1.0; },
+                               std::make_unique<AdditiveRungeKutta>(one, zero, std::vector<double>{0.0}, 0.0,
+                                                                    zeroJacobian), 0.0, 0.0);
+    wrapped.setEvents({half});
+    EXPECT_EQ(wrapped.solve(0.1, 2.0).size(), 6);
+    ASSERT_EQ(wrapped.eventLog().size(), 1);
+    EXPECT_NEAR(wrapped.eventLog()[0].t, 0.55, 1e-10);
+
+    // A terminal event inside a step drops the sensitivities of the dropped state as well, y' = -p y with p = 1
+    SystemFunction decay = [](const std::vector<double>& y, double t, std::vector<double>& dydt) { dydt[0] = -y[0]; };
+    DenseJacobianFunction decayJacobian = [](const std::vector<double>& y, double t, std::vector<double>& J) {
+        J[0] = -1.0;
+    };
+    ImplicitEulerSystem sensitive(decay, {1.0}, 0.0, decayJacobian);
+    sensitive.setSensitivities([](const std::vector<double>& y, double t, std::vector<double>& dfdp) {
+        dfdp[0] = -y[0];
+    }, 1);
+    Event halfLife;
+    halfLife.g = [](const std::vector<double>& y, double t) { return y[0] - 0.5; };
+    halfLife.terminal = true;
+    sensitive.setEvents({halfLife});
+    std::vector<std::vector<double>> decayed = sensitive.solve(0.1, 2.0);
+    ASSERT_EQ(sensitive.eventLog().size(), 1);
+    EXPECT_LT(decayed.size(), 21);
+    EXPECT_EQ(sensitive.sensitivities().size(), decayed.size());
+
+    // Solvers that cannot locate events reject them
+    DelayFunction delayed = [](const std::vector<double>& y, const std::vector<std::vector<double>>& yDelayed,
+                               double t, std::vector<double>& dydt) {
+        dydt[0] = -yDelayed[0][0];
+    };
+    DelayRungeKutta delay(delayed, {1.0}, [](double t) { return std::vector<double>{1.0}; }, 0.0);
+    EXPECT_THROW(delay.setEvents({half}), std::invalid_argument);
+    ImplicitEulerSystem dae(one, {0.0}, 0.0, zeroJacobian);
+    dae.setMassMatrix([](const std::vector<double>& y, double t, CSRMatrix& M) {
+        M = CSRMatrix::fromTriplets(1, 1, {{0, 0, 1.0}});
+    });
+    dae.setEvents({half});
+    EXPECT_THROW(dae.solve(0.1, 2.0), std::invalid_argument);
+}
+
+TEST(LinearAlgebra, ILU0) {
+    // Without fill-in ILU(0) of a tridiagonal matrix is the exact LU factorization
+    const unsigned int n = 50;
+    std::vector<Triplet> triplets;
+    for (unsigned int i = 0; i < n; i++) {
+        triplets.push_back({i, i, 3.0});
+        if (i > 0) triplets.push_back({i, i - 1, -1.0});
+        if (i + 1 < n) triplets.push_back({i, i + 1, -1.5});
+    }
+    CSRMatrix A = CSRMatrix::fromTriplets(n, n, triplets);
+    std::vector<double> x(n), b;
+    for (unsigned int i = 0; i < n; i++) {
+        x[i] = sin(i);
+    }
+    A.multiply(x, b);
+    ILU0 ilu;
+    ilu.factorize(A);
+    ilu.solve(b);
+    EXPECT_LE(utilities::calculateRMSE(b, x), 1e-12);
+}
+
+TEST(LinearAlgebra, GMRES) {
+    const unsigned int m = 20;
+    CSRMatrix A = laplacianNewtonMatrix(m, 1.0);
+    std::vector<double> x(A.rows), b, solution;
+    for (unsigned int i = 0; i < A.rows; i++) {
+        x[i] = cos(i);
+    }
+    A.multiply(x, b);
+    GMRES gmres(10, 1e-10, 1000);
+    EXPECT_TRUE(gmres.solve([&A](const std::vector<double>& v, std::vector<double>& Av) { A.multiply(v, Av); },
+                            b, solution));
+    EXPECT_LE(utilities::calculateRMSE(solution, x), 1e-8);
+
+    // Breakdown for a singular A with A b = 0, the solve stops without dividing by zero
+    std::vector<double> singular = {0.0, 0.0};
+    EXPECT_FALSE(gmres.solve([](const std::vector<double>& v, std::vector<double>& Av) { Av = {0.0, v[1]}; },
+                             {1.0, 0.0}, singular));
+    EXPECT_TRUE(std::isfinite(singular[0]) && std::isfinite(singular[1]));
+}
+
+int main(int argc, char **argv) {
     configurations.emplace_back(TestConfiguration{
             {
                     "linearODE",
@@ -112,7 +1650,7 @@ int main() {
             [](double t) { return 2 * exp(1) * exp(-cos(t)) - 1; }
     });
     configurations[1].fill_yValues();
-    InitGoogleTest();
+    InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
 }
 